@@ -2,219 +2,124 @@
 #include "player.h"
 #include "item.h"
 #include "../rendering/bitmap_font.h"
+#include "../rendering/sprite_batch.h"
+#include "../rendering/text_label.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
 
-Enemy::Enemy() 
-    : m_x(0), m_y(0), m_speed(DEFAULT_SPEED), m_active(false), m_level(1), 
-      m_originalLevel(1), m_spawnTime(0), m_knockbackX(0), m_knockbackY(0), m_knockbackEndTime(0) {
-}
-
-void Enemy::initialize(int x, int y, int level, float speed, Uint32 spawnTime) {
-    m_x = x;
-    m_y = y;
-    m_level = level;
-    m_originalLevel = level;
-    m_speed = speed;
-    m_spawnTime = spawnTime;
-    m_active = true;
-    m_knockbackX = 0;
-    m_knockbackY = 0;
-    m_knockbackEndTime = 0;
-}
-
-void Enemy::update(const Player& player, const std::vector<Enemy>& enemies, 
-                   int worldWidth, int worldHeight, Uint32 currentTime) {
-    if (!m_active) return;
-    
-    // Handle knockback
-    if (isInKnockback(currentTime)) {
-        m_x += m_knockbackX * 0.1f; // Apply knockback gradually
-        m_y += m_knockbackY * 0.1f;
-    } else {
-        // Normal movement and collision avoidance
-        moveTowardsPlayer(player);
-        applyCollisionAvoidance(enemies);
-    }
+void Enemy::update(EnemyStore& enemies, size_t index, const Player& player, const FlowField& flowField,
+                   const std::vector<int>& nearbyEnemyIndices, SeparationCandidates& candidates,
+                   int worldWidth, int worldHeight, const FrameTime& time) {
+    if (!enemies.isActive(index)) return;
     
-    // Check world bounds
-    checkWorldBounds(worldWidth, worldHeight);
-}
-
-void Enemy::updateWithSpatialPartitioning(const Player& player, const std::vector<Enemy>& enemies,
-                                         int worldWidth, int worldHeight, Uint32 currentTime,
-                                         const std::vector<int>& nearbyEnemyIndices) {
-    if (!m_active) return;
+    float stepScale = time.stepScale;
     
     // Handle knockback
-    if (isInKnockback(currentTime)) {
-        m_x += m_knockbackX * 0.1f; // Apply knockback gradually
-        m_y += m_knockbackY * 0.1f;
+    if (enemies.isInKnockback(index, time.simTime)) {
+        // Apply knockback gradually
+        enemies.moveBy(index, enemies.getKnockbackX(index) * 0.1f * stepScale,
+                       enemies.getKnockbackY(index) * 0.1f * stepScale);
     } else {
         // Normal movement and collision avoidance with spatial partitioning
-        moveTowardsPlayer(player);
-        applyCollisionAvoidanceWithSpatialPartitioning(enemies, nearbyEnemyIndices);
+        moveTowardsPlayer(enemies, index, player, flowField, stepScale);
+        applyCollisionAvoidance(enemies, index, nearbyEnemyIndices, candidates, stepScale);
     }
     
     // Check world bounds
-    checkWorldBounds(worldWidth, worldHeight);
+    checkWorldBounds(enemies, index, worldWidth, worldHeight);
 }
 
-void Enemy::render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY) const {
-    if (!m_active) return;
+void Enemy::render(const EnemyStore& enemies, size_t index, SpriteBatch& batch, SDL_Texture* texture,
+                   int cameraOffsetX, int cameraOffsetY, const FrameTime& time) {
+    if (!enemies.isActive(index)) return;
     
-    SDL_Rect destRect = {m_x + cameraOffsetX, m_y + cameraOffsetY, getSize(), getSize()};
+    int size = enemies.getSize(index);
+    int level = enemies.getLevel(index);
+    SDL_Rect destRect = {interpolatePosition(enemies.getPrevX(index), enemies.getX(index), time.alpha) + cameraOffsetX,
+                         interpolatePosition(enemies.getPrevY(index), enemies.getY(index), time.alpha) + cameraOffsetY,
+                         size, size};
     
     if (texture) {
-        SDL_RenderCopy(renderer, texture, nullptr, &destRect);
+        batch.draw(texture, nullptr, destRect);
     } else {
         // Fallback to colored rectangle
-        int redIntensity = 100 + (m_level * 15);
+        int redIntensity = 100 + (level * 15);
         if (redIntensity > 255) redIntensity = 255;
-        SDL_SetRenderDrawColor(renderer, redIntensity, 100, 100, 255);
-        SDL_RenderFillRect(renderer, &destRect);
+        batch.fillRect(destRect, {static_cast<Uint8>(redIntensity), 100, 100, 255});
     }
 }
 
-void Enemy::render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY, BitmapFont* font) const {
-    if (!m_active) return;
+void Enemy::renderLabel(const EnemyStore& enemies, size_t index, SpriteBatch& batch, BitmapFont* font,
+                        TextLabel* levelLabels, int cameraOffsetX, int cameraOffsetY, const FrameTime& time) {
+    if (!enemies.isActive(index) || !font) return;
     
-    // Render the enemy sprite/rectangle first
-    render(renderer, texture, cameraOffsetX, cameraOffsetY);
+    int size = enemies.getSize(index);
+    int x = interpolatePosition(enemies.getPrevX(index), enemies.getX(index), time.alpha) + cameraOffsetX;
+    int y = interpolatePosition(enemies.getPrevY(index), enemies.getY(index), time.alpha) + cameraOffsetY;
     
     // Render level number on top of enemy
-    if (font) {
-        std::string levelText = std::to_string(m_level);
-        int textX = m_x + cameraOffsetX + getSize() / 2 - (levelText.length() * 4); // Center the text
-        int textY = m_y + cameraOffsetY + getSize() / 2 - 4; // Center vertically
-        
-        SDL_Color textColor = {255, 255, 255, 255}; // White text
-        font->renderText(renderer, levelText, textX, textY, textColor);
-    }
-}
-
-void Enemy::takeDamage() {
-    m_level--;
-    if (m_level <= 0) {
-        m_active = false;
-    }
-}
-
-void Enemy::applyKnockback(float dx, float dy, float distance, Uint32 currentTime) {
-    if (distance > 0) {
-        dx /= distance;
-        dy /= distance;
-        float knockbackDist = getSize() * KNOCKBACK_DISTANCE_MULTIPLIER;
-        m_knockbackX = dx * knockbackDist;
-        m_knockbackY = dy * knockbackDist;
-        m_knockbackEndTime = currentTime + KNOCKBACK_DURATION;
-    }
-}
-
-bool Enemy::checkCollision(const SDL_Rect& otherRect) const {
-    if (!m_active) return false;
-    SDL_Rect myRect = getRect();
-    return SDL_HasIntersection(&myRect, &otherRect);
-}
-
-bool Enemy::checkCollisionWithPlayer(const Player& player) const {
-    if (!m_active) return false;
-    return checkCollision(player.getRect());
+    TextLabel& label = levelLabels[enemies.getLevel(index) - 1];
+    int textX = x + size / 2 - (label.getLength() * 4); // Center the text
+    int textY = y + size / 2 - 4; // Center vertically
+    
+    SDL_Color textColor = {255, 255, 255, 255}; // White text
+    label.render(batch, *font, textX, textY, textColor);
 }
 
-void Enemy::moveTowardsPlayer(const Player& player) {
-    float dx = player.getX() - m_x;
-    float dy = player.getY() - m_y;
-    float distance = sqrt(dx * dx + dy * dy);
+void Enemy::moveTowardsPlayer(EnemyStore& enemies, size_t index, const Player& player,
+                              const FlowField& flowField, float stepScale) {
+    float dx, dy;
     
-    if (distance > 0) {
-        // Normalize direction and move towards player
+    // Heading from the flow field; seek directly outside it and close to the player
+    if (!flowField.sample(enemies.getCenterX(index), enemies.getCenterY(index), dx, dy)) {
+        dx = player.getX() - enemies.getX(index);
+        dy = player.getY() - enemies.getY(index);
+        float distance = sqrt(dx * dx + dy * dy);
+        if (distance <= 0) return;
+        
+        // Normalize direction
         dx /= distance;
         dy /= distance;
-        m_x += dx * m_speed;
-        m_y += dy * m_speed;
     }
+    
+    float speed = enemies.getSpeed(index) * stepScale;
+    enemies.moveBy(index, dx * speed, dy * speed);
 }
 
-void Enemy::applyCollisionAvoidance(const std::vector<Enemy>& enemies) {
-    float avoidX = 0, avoidY = 0;
-    int centerX = getCenterX();
-    int centerY = getCenterY();
-    
-    for (const Enemy& other : enemies) {
-        if (!other.m_active || &other == this) continue;
+void Enemy::applyCollisionAvoidance(EnemyStore& enemies, size_t index,
+                                    const std::vector<int>& nearbyEnemyIndices,
+                                    SeparationCandidates& candidates, float stepScale) {
+    // Gather nearby enemy centres and radii once, then push them through the batched kernel.
+    // Neighbours are read only from the previous-tick buffer (other chunks may be
+    // moving or deactivating them right now); only this enemy's own slot is written.
+    candidates.clear();
+    for (int enemyIndex : nearbyEnemyIndices) {
+        size_t other = static_cast<size_t>(enemyIndex);
+        if (other == index || other >= enemies.size() || !enemies.wasActive(other)) continue;
         
-        calculateAvoidanceForce(other, avoidX, avoidY);
+        candidates.add(static_cast<float>(enemies.getPrevCenterX(other)),
+                       static_cast<float>(enemies.getPrevCenterY(other)),
+                       enemies.getPrevSize(other) / 2.0f);
     }
     
-    // Apply avoidance forces
-    m_x += avoidX;
-    m_y += avoidY;
-}
-
-void Enemy::applyCollisionAvoidanceWithSpatialPartitioning(const std::vector<Enemy>& enemies, 
-                                                          const std::vector<int>& nearbyEnemyIndices) {
     float avoidX = 0, avoidY = 0;
-    
-    // Only check nearby enemies instead of all enemies
-    for (int enemyIndex : nearbyEnemyIndices) {
-        if (enemyIndex >= 0 && enemyIndex < enemies.size()) {
-            const Enemy& other = enemies[enemyIndex];
-            if (!other.m_active || &other == this) continue;
-            
-            calculateAvoidanceForce(other, avoidX, avoidY);
-        }
-    }
+    accumulateSeparation(static_cast<float>(enemies.getCenterX(index)),
+                         static_cast<float>(enemies.getCenterY(index)),
+                         enemies.getSize(index) / 2.0f, MIN_DISTANCE, SEPARATION_FORCE,
+                         candidates, avoidX, avoidY);
     
     // Apply avoidance forces
-    m_x += avoidX;
-    m_y += avoidY;
+    enemies.moveBy(index, avoidX * stepScale, avoidY * stepScale);
 }
 
-void Enemy::calculateAvoidanceForce(const Enemy& other, float& avoidX, float& avoidY) const {
-    // Cache center positions and sizes to avoid multiple function calls
-    int myCenterX = getCenterX();
-    int myCenterY = getCenterY();
-    int mySize = getSize();
-    int otherCenterX = other.getCenterX();
-    int otherCenterY = other.getCenterY();
-    int otherSize = other.getSize();
-    
-    // Calculate squared distance (avoid expensive sqrt)
-    float dx_dist = myCenterX - otherCenterX;
-    float dy_dist = myCenterY - otherCenterY;
-    float distSquared = dx_dist * dx_dist + dy_dist * dy_dist;
-    
-    // Calculate minimum distance squared (sum of radii)
-    float minDistance = (mySize + otherSize) / 2.0f + MIN_DISTANCE;
-    float minDistanceSquared = minDistance * minDistance;
-    
-    // Early exit if too far apart (using squared distance)
-    if (distSquared >= minDistanceSquared || distSquared == 0) {
-        return;
-    }
-    
-    // Only now calculate actual distance for force calculation
-    float dist = sqrt(distSquared);
-    
-    // Calculate avoidance force
-    float avoidanceForce = SEPARATION_FORCE * (minDistance - dist) / minDistance;
-    
-    // Normalize direction (avoid division by zero)
-    dx_dist /= dist;
-    dy_dist /= dist;
-    
-    // Add to avoidance forces
-    avoidX += dx_dist * avoidanceForce;
-    avoidY += dy_dist * avoidanceForce;
-}
-
-void Enemy::checkWorldBounds(int worldWidth, int worldHeight) {
-    int enemySize = getSize();
-    if (m_x < -enemySize * 2 || m_x > worldWidth + enemySize * 2 ||
-        m_y < -enemySize * 2 || m_y > worldHeight + enemySize * 2) {
-        m_active = false;
+void Enemy::checkWorldBounds(EnemyStore& enemies, size_t index, int worldWidth, int worldHeight) {
+    int enemySize = enemies.getSize(index);
+    int x = enemies.getX(index);
+    int y = enemies.getY(index);
+    if (x < -enemySize * 2 || x > worldWidth + enemySize * 2 ||
+        y < -enemySize * 2 || y > worldHeight + enemySize * 2) {
+        enemies.setActive(index, false);
     }
 }
 
@@ -231,17 +136,22 @@ int Enemy::getEnemyCenterY(int enemyY, int enemySize) {
     return enemyY + enemySize / 2;
 }
 
-void Enemy::getShardProperties(int& value, SDL_Color& color) const {
-    if (m_originalLevel >= 8) {
+int Enemy::getMaxAvoidanceRange() {
+    // Largest centre-to-centre distance at which two enemies still push apart
+    return getEnemySize(MAX_ENEMY_LEVEL) + static_cast<int>(std::ceil(MIN_DISTANCE));
+}
+
+void Enemy::getShardProperties(int originalLevel, int& value, SDL_Color& color) {
+    if (originalLevel >= 8) {
         value = 25;
         color = {128, 0, 128, 255}; // Purple
-    } else if (m_originalLevel >= 6) {
+    } else if (originalLevel >= 6) {
         value = 20;
         color = {0, 0, 255, 255}; // Blue
-    } else if (m_originalLevel >= 4) {
+    } else if (originalLevel >= 4) {
         value = 15;
         color = {0, 255, 0, 255}; // Green
-    } else if (m_originalLevel >= 2) {
+    } else if (originalLevel >= 2) {
         value = 10;
         color = {255, 165, 0, 255}; // Orange
     } else {
@@ -250,39 +160,42 @@ void Enemy::getShardProperties(int& value, SDL_Color& color) const {
     }
 }
 
-void Enemy::handleDeath(std::vector<Item>& items, Uint32 currentTime) {
+void Enemy::handleDeath(const EnemyStore& enemies, size_t index, ItemStore& items, Uint32 currentTime,
+                        Random& random) {
+    int centerX = enemies.getCenterX(index);
+    int centerY = enemies.getCenterY(index);
+    
     // Create shard item
-    Item shard;
     int shardValue;
     SDL_Color shardColor;
-    getShardProperties(shardValue, shardColor);
-    shard.initialize(getCenterX() - Item::SHARD_SIZE/2, 
-                    getCenterY() - Item::SHARD_SIZE/2, 
-                    ItemType::SHARD, currentTime, shardValue, shardColor);
-    items.push_back(shard);
+    getShardProperties(enemies.getOriginalLevel(index), shardValue, shardColor);
+    if (items.add(centerX - Item::SHARD_SIZE/2, 
+                  centerY - Item::SHARD_SIZE/2, 
+                  ItemType::SHARD, currentTime, shardValue, shardColor) < 0) {
+        // Store full: fold the value into the nearest shard so none is lost
+        // (coalescing only runs at the end of the tick)
+        int nearest = items.findNearestShard(centerX, centerY);
+        if (nearest >= 0) {
+            items.setValue(nearest, items.getValue(nearest) + shardValue);
+        }
+    }
     
-    // 1% chance to drop magnet
-    if (shouldDropMagnet()) {
-        Item magnet;
-        magnet.initialize(getCenterX() - Item::MAGNET_SIZE/2, 
-                        getCenterY() - Item::MAGNET_SIZE/2, 
-                        ItemType::MAGNET, currentTime);
-        items.push_back(magnet);
+    // 1% chance to drop magnet (rolled even when the store is full, so drops
+    // don't shift the random sequence)
+    if (shouldDropMagnet(random)) {
+        items.add(centerX - Item::MAGNET_SIZE/2, 
+                  centerY - Item::MAGNET_SIZE/2, 
+                  ItemType::MAGNET, currentTime);
     }
 }
 
-bool Enemy::shouldDropMagnet() const {
-    return (rand() % 100) < Item::MAGNET_DROP_CHANCE;
-}
-
-Enemy Enemy::createEnemy(int x, int y, int level, float speed, Uint32 spawnTime) {
-    Enemy enemy;
-    enemy.initialize(x, y, level, speed, spawnTime);
-    return enemy;
+bool Enemy::shouldDropMagnet(Random& random) {
+    return random.chance(Item::MAGNET_DROP_CHANCE);
 }
 
-int Enemy::calculateLevel(int playerScore) {
-    int level = 1 + (playerScore / 10);
+int Enemy::calculateLevel(int playerScore, int startLevel, int scorePerLevel, int maxLevel) {
+    int level = startLevel + (playerScore / std::max(1, scorePerLevel));
+    if (level > maxLevel) level = maxLevel;
     if (level > MAX_ENEMY_LEVEL) level = MAX_ENEMY_LEVEL;
     return level;
 }
\ No newline at end of file
@@ -1,66 +1,54 @@
 #pragma once
 #include <SDL.h>
 #include <vector>
+#include "enemy_store.h"
+#include "item_store.h"
+#include "../utils/simd_kernels.h"
+#include "../utils/random.h"
+#include "../systems/frame_clock.h"
+#include "../systems/flow_field.h"
 
 // Forward declarations
 class Player;
-class Item;
+class SpriteBatch;
+class BitmapFont;
+class TextLabel;
 
+// Enemy behaviour and tuning. Per-enemy state lives in EnemyStore; these
+// functions operate on one enemy of the store, identified by its index.
 class Enemy {
 public:
-    // Constructor
-    Enemy();
-    
-    // Initialize enemy with position and properties
-    void initialize(int x, int y, int level, float speed, Uint32 spawnTime);
-    
     // Update enemy state (movement, collision avoidance, etc.)
-    void update(const Player& player, const std::vector<Enemy>& enemies, 
-                int worldWidth, int worldHeight, Uint32 currentTime);
-    
-    // Update with spatial partitioning for better performance
-    void updateWithSpatialPartitioning(const Player& player, const std::vector<Enemy>& enemies,
-                                     int worldWidth, int worldHeight, Uint32 currentTime,
-                                     const std::vector<int>& nearbyEnemyIndices);
-    
-    // Render the enemy
-    void render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY) const;
-    void render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY, class BitmapFont* font) const;
-    
-    // Getters
-    int getX() const { return m_x; }
-    int getY() const { return m_y; }
-    int getCenterX() const { return m_x + getSize() / 2; }
-    int getCenterY() const { return m_y + getSize() / 2; }
-    int getSize() const { return BASE_SIZE + (m_level - 1) * 2; }
-    int getLevel() const { return m_level; }
-    int getOriginalLevel() const { return m_originalLevel; }
-    bool isActive() const { return m_active; }
-    SDL_Rect getRect() const { return {m_x, m_y, getSize(), getSize()}; }
-    
-    // Setters
-    void setPosition(int x, int y) { m_x = x; m_y = y; }
-    void setActive(bool active) { m_active = active; }
-    
-    // Combat methods
-    void takeDamage();
-    void applyKnockback(float dx, float dy, float distance, Uint32 currentTime);
-    bool isInKnockback(Uint32 currentTime) const { return currentTime < m_knockbackEndTime; }
+    // nearbyEnemyIndices comes from GameManager's spatial grid query for this enemy;
+    // candidates is caller-owned scratch space for the batched separation kernel.
+    // flowField gives the pursuit heading; it must already point at the player.
+    // Only this enemy's slot is written, so different indices may update concurrently.
+    static void update(EnemyStore& enemies, size_t index, const Player& player, const FlowField& flowField,
+                       const std::vector<int>& nearbyEnemyIndices, SeparationCandidates& candidates,
+                       int worldWidth, int worldHeight, const FrameTime& time);
+    
+    // Render the enemy, interpolated between its previous and current tick positions
+    static void render(const EnemyStore& enemies, size_t index, SpriteBatch& batch, SDL_Texture* texture,
+                       int cameraOffsetX, int cameraOffsetY, const FrameTime& time);
+    
+    // Render the level number centred on the enemy (a separate pass, so the
+    // sprites and the labels each batch into as few draw calls as possible).
+    // levelLabels holds the pre-composed labels for levels 1..MAX_ENEMY_LEVEL.
+    static void renderLabel(const EnemyStore& enemies, size_t index, SpriteBatch& batch, BitmapFont* font,
+                            TextLabel* levelLabels, int cameraOffsetX, int cameraOffsetY, const FrameTime& time);
     
     // Death and item drop logic
-    void handleDeath(std::vector<Item>& items, Uint32 currentTime);
-    bool shouldDropMagnet() const;
+    // Drops are skipped if the item store is full
+    static void handleDeath(const EnemyStore& enemies, size_t index, ItemStore& items, Uint32 currentTime,
+                            Random& random);
+    static bool shouldDropMagnet(Random& random);
     
     // Shard properties when enemy is defeated
-    void getShardProperties(int& value, SDL_Color& color) const;
+    static void getShardProperties(int originalLevel, int& value, SDL_Color& color);
     
-    // Static factory methods
-    static Enemy createEnemy(int x, int y, int level, float speed, Uint32 spawnTime);
-    static int calculateLevel(int playerScore);
-    
-    // Collision detection
-    bool checkCollision(const SDL_Rect& otherRect) const;
-    bool checkCollisionWithPlayer(const Player& player) const;
+    // Level scaling: startLevel + playerScore / scorePerLevel, capped at maxLevel
+    static int calculateLevel(int playerScore, int startLevel = 1, int scorePerLevel = 10,
+                              int maxLevel = MAX_ENEMY_LEVEL);
     
     // Static constants
     static constexpr int BASE_SIZE = 12;
@@ -70,38 +58,21 @@ public:
     static constexpr float MIN_DISTANCE = 3.0f;
     static constexpr int KNOCKBACK_DURATION = 200; // milliseconds
     
-    // Game-wide enemy constants
-    static constexpr int MAX_ENEMIES = 500; // Increased for stress testing
-    static constexpr int ENEMY_SPAWN_RATE = 50; // milliseconds between spawns (10x faster for stress testing)
+    // Game-wide enemy constants (the enemy cap and spawn rate come from the Scenario)
     static constexpr int MAX_ENEMY_LEVEL = 10;
     
     // Helper functions
     static int getEnemySize(int level);
     static int getEnemyCenterX(int enemyX, int enemySize);
     static int getEnemyCenterY(int enemyY, int enemySize);
-    
+    static int getMaxAvoidanceRange();
+
 private:
-    // Position and movement
-    int m_x, m_y;
-    float m_speed;
-    
-    // State
-    bool m_active;
-    int m_level;
-    int m_originalLevel;
-    Uint32 m_spawnTime;
-    
-    // Knockback system
-    float m_knockbackX, m_knockbackY;
-    Uint32 m_knockbackEndTime;
-    
     // Helper methods
-    void moveTowardsPlayer(const Player& player);
-    void applyCollisionAvoidance(const std::vector<Enemy>& enemies);
-    void checkWorldBounds(int worldWidth, int worldHeight);
-    
-    // Collision avoidance helpers
-    void calculateAvoidanceForce(const Enemy& other, float& avoidX, float& avoidY) const;
-    void applyCollisionAvoidanceWithSpatialPartitioning(const std::vector<Enemy>& enemies, 
-                                                       const std::vector<int>& nearbyEnemyIndices);
+    static void moveTowardsPlayer(EnemyStore& enemies, size_t index, const Player& player,
+                                  const FlowField& flowField, float stepScale);
+    static void applyCollisionAvoidance(EnemyStore& enemies, size_t index,
+                                        const std::vector<int>& nearbyEnemyIndices,
+                                        SeparationCandidates& candidates, float stepScale);
+    static void checkWorldBounds(EnemyStore& enemies, size_t index, int worldWidth, int worldHeight);
 };
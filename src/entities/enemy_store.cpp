@@ -0,0 +1,167 @@
+#include "enemy_store.h"
+#include "enemy.h"
+
+EnemyStore::EnemyStore() {
+}
+
+EnemyStore::~EnemyStore() {
+    // Cleanup handled by vector destructors
+}
+
+void EnemyStore::reserve(size_t capacity) {
+    m_x.reserve(capacity);
+    m_y.reserve(capacity);
+    m_prevX.reserve(capacity);
+    m_prevY.reserve(capacity);
+    m_prevSize.reserve(capacity);
+    m_prevActive.reserve(capacity);
+    m_size.reserve(capacity);
+    m_level.reserve(capacity);
+    m_active.reserve(capacity);
+    m_knockbackX.reserve(capacity);
+    m_knockbackY.reserve(capacity);
+    m_knockbackEndTime.reserve(capacity);
+    m_speed.reserve(capacity);
+    m_originalLevel.reserve(capacity);
+    m_spawnTime.reserve(capacity);
+    m_lastStepTick.reserve(capacity);
+    m_stepPhase.reserve(capacity);
+}
+
+void EnemyStore::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_prevX.clear();
+    m_prevY.clear();
+    m_prevSize.clear();
+    m_prevActive.clear();
+    m_size.clear();
+    m_level.clear();
+    m_active.clear();
+    m_knockbackX.clear();
+    m_knockbackY.clear();
+    m_knockbackEndTime.clear();
+    m_speed.clear();
+    m_originalLevel.clear();
+    m_spawnTime.clear();
+    m_lastStepTick.clear();
+    m_stepPhase.clear();
+}
+
+size_t EnemyStore::getActiveCount() const {
+    size_t count = 0;
+    for (Uint8 active : m_active) {
+        count += active;
+    }
+    return count;
+}
+
+size_t EnemyStore::add(int x, int y, int level, float speed, Uint32 spawnTime) {
+    m_x.push_back(static_cast<float>(x));
+    m_y.push_back(static_cast<float>(y));
+    m_prevX.push_back(static_cast<float>(x));
+    m_prevY.push_back(static_cast<float>(y));
+    m_prevSize.push_back(Enemy::getEnemySize(level));
+    m_prevActive.push_back(1);
+    m_size.push_back(Enemy::getEnemySize(level));
+    m_level.push_back(level);
+    m_active.push_back(1);
+    m_knockbackX.push_back(0);
+    m_knockbackY.push_back(0);
+    m_knockbackEndTime.push_back(0);
+    m_speed.push_back(speed);
+    m_originalLevel.push_back(level);
+    m_spawnTime.push_back(spawnTime);
+    m_lastStepTick.push_back(0);
+    m_stepPhase.push_back(static_cast<Uint8>(m_stepPhase.size()));
+    return m_x.size() - 1;
+}
+
+void EnemyStore::removeInactive(std::vector<int>* remap) {
+    size_t count = m_x.size();
+    size_t write = 0;
+    if (remap) {
+        remap->assign(count, -1);
+    }
+    
+    for (size_t read = 0; read < count; read++) {
+        if (!m_active[read]) continue;
+        
+        if (remap) {
+            (*remap)[read] = static_cast<int>(write);
+        }
+        
+        if (write != read) {
+            m_x[write] = m_x[read];
+            m_y[write] = m_y[read];
+            m_prevX[write] = m_prevX[read];
+            m_prevY[write] = m_prevY[read];
+            m_prevSize[write] = m_prevSize[read];
+            m_prevActive[write] = m_prevActive[read];
+            m_size[write] = m_size[read];
+            m_level[write] = m_level[read];
+            m_active[write] = m_active[read];
+            m_knockbackX[write] = m_knockbackX[read];
+            m_knockbackY[write] = m_knockbackY[read];
+            m_knockbackEndTime[write] = m_knockbackEndTime[read];
+            m_speed[write] = m_speed[read];
+            m_originalLevel[write] = m_originalLevel[read];
+            m_spawnTime[write] = m_spawnTime[read];
+            m_lastStepTick[write] = m_lastStepTick[read];
+            m_stepPhase[write] = m_stepPhase[read];
+        }
+        write++;
+    }
+    
+    if (write == count) return;
+    
+    m_x.resize(write);
+    m_y.resize(write);
+    m_prevX.resize(write);
+    m_prevY.resize(write);
+    m_prevSize.resize(write);
+    m_prevActive.resize(write);
+    m_size.resize(write);
+    m_level.resize(write);
+    m_active.resize(write);
+    m_knockbackX.resize(write);
+    m_knockbackY.resize(write);
+    m_knockbackEndTime.resize(write);
+    m_speed.resize(write);
+    m_originalLevel.resize(write);
+    m_spawnTime.resize(write);
+    m_lastStepTick.resize(write);
+    m_stepPhase.resize(write);
+}
+
+void EnemyStore::snapshotPositions() {
+    m_prevX.assign(m_x.begin(), m_x.end());
+    m_prevY.assign(m_y.begin(), m_y.end());
+    m_prevSize.assign(m_size.begin(), m_size.end());
+    m_prevActive.assign(m_active.begin(), m_active.end());
+}
+
+void EnemyStore::takeDamage(size_t i) {
+    m_level[i]--;
+    m_size[i] = Enemy::getEnemySize(m_level[i]);
+    if (m_level[i] <= 0) {
+        m_active[i] = 0;
+    }
+}
+
+void EnemyStore::applyKnockback(size_t i, float dx, float dy, float distance, Uint32 currentTime) {
+    if (distance > 0) {
+        dx /= distance;
+        dy /= distance;
+        float knockbackDist = m_size[i] * Enemy::KNOCKBACK_DISTANCE_MULTIPLIER;
+        m_knockbackX[i] = dx * knockbackDist;
+        m_knockbackY[i] = dy * knockbackDist;
+        m_knockbackEndTime[i] = currentTime + Enemy::KNOCKBACK_DURATION;
+    }
+}
+
+bool EnemyStore::checkCollision(size_t i, const SDL_Rect& otherRect) const {
+    if (!m_active[i]) return false;
+    SDL_Rect myRect = getRect(i);
+    return SDL_HasIntersection(&myRect, &otherRect);
+}
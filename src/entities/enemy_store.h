@@ -0,0 +1,104 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "../utils/subpixel.h"
+
+// Structure-of-arrays storage for every enemy in the game.
+// Hot per-tick data (position, size/level, active flag) sits in its own
+// contiguous arrays so movement and collision loops stream over it; knockback
+// and cold spawn data are kept in separate arrays that those loops rarely touch.
+// Positions are stored sub-pixel and read back as whole pixels.
+class EnemyStore {
+public:
+    EnemyStore();
+    ~EnemyStore();
+    
+    // Capacity management
+    void reserve(size_t capacity);
+    void clear();
+    size_t size() const { return m_x.size(); }
+    bool empty() const { return m_x.empty(); }
+    size_t getActiveCount() const;
+    
+    // Add a new active enemy and return its index
+    size_t add(int x, int y, int level, float speed, Uint32 spawnTime);
+    
+    // Compact out inactive enemies (relative order of the rest is kept).
+    // If remap is given it receives each old index's new index, or -1 if removed.
+    void removeInactive(std::vector<int>* remap = nullptr);
+    
+    // Copy current positions, sizes and active flags into the previous-tick
+    // buffer. The enemy step reads neighbours only from that buffer (never
+    // the live arrays, which other chunks write), so enemies can be updated
+    // in any order (or in parallel) with the same result.
+    void snapshotPositions();
+    
+    // Hot data
+    int getX(size_t i) const { return toPixel(m_x[i]); }
+    int getY(size_t i) const { return toPixel(m_y[i]); }
+    int getSize(size_t i) const { return m_size[i]; }
+    int getLevel(size_t i) const { return m_level[i]; }
+    int getCenterX(size_t i) const { return getX(i) + m_size[i] / 2; }
+    int getCenterY(size_t i) const { return getY(i) + m_size[i] / 2; }
+    bool isActive(size_t i) const { return m_active[i] != 0; }
+    SDL_Rect getRect(size_t i) const { return {getX(i), getY(i), m_size[i], m_size[i]}; }
+    
+    // State as of the last snapshotPositions()
+    int getPrevX(size_t i) const { return toPixel(m_prevX[i]); }
+    int getPrevY(size_t i) const { return toPixel(m_prevY[i]); }
+    int getPrevSize(size_t i) const { return m_prevSize[i]; }
+    int getPrevCenterX(size_t i) const { return getPrevX(i) + m_prevSize[i] / 2; }
+    int getPrevCenterY(size_t i) const { return getPrevY(i) + m_prevSize[i] / 2; }
+    bool wasActive(size_t i) const { return m_prevActive[i] != 0; }
+    
+    // Cold data
+    int getOriginalLevel(size_t i) const { return m_originalLevel[i]; }
+    float getSpeed(size_t i) const { return m_speed[i]; }
+    Uint32 getSpawnTime(size_t i) const { return m_spawnTime[i]; }
+    
+    // Tick the enemy's position was last brought up to date (its spawn tick
+    // until it first steps); enemies in reduced-rate LOD bands cover all the
+    // ticks since then in one step
+    Uint64 getLastStepTick(size_t i) const { return m_lastStepTick[i]; }
+    void setLastStepTick(size_t i, Uint64 tick) { m_lastStepTick[i] = tick; }
+    
+    // Fixed per-enemy offset (its index when added) that staggers which tick
+    // reduced-rate LOD bands step it on, so a band doesn't step all at once
+    int getStepPhase(size_t i) const { return m_stepPhase[i]; }
+    
+    // Setters
+    void setPosition(size_t i, int x, int y) { m_x[i] = static_cast<float>(x); m_y[i] = static_cast<float>(y); }
+    void moveBy(size_t i, float dx, float dy) { m_x[i] += dx; m_y[i] += dy; }
+    void setActive(size_t i, bool active) { m_active[i] = active ? 1 : 0; }
+    
+    // Combat methods
+    void takeDamage(size_t i);
+    void applyKnockback(size_t i, float dx, float dy, float distance, Uint32 currentTime);
+    bool isInKnockback(size_t i, Uint32 currentTime) const { return currentTime < m_knockbackEndTime[i]; }
+    float getKnockbackX(size_t i) const { return m_knockbackX[i]; }
+    float getKnockbackY(size_t i) const { return m_knockbackY[i]; }
+    
+    // Collision detection
+    bool checkCollision(size_t i, const SDL_Rect& otherRect) const;
+
+private:
+    // Hot data
+    std::vector<float> m_x, m_y;
+    std::vector<float> m_prevX, m_prevY;
+    std::vector<int> m_prevSize;
+    std::vector<Uint8> m_prevActive;
+    std::vector<int> m_size;
+    std::vector<int> m_level;
+    std::vector<Uint8> m_active;
+    
+    // Knockback
+    std::vector<float> m_knockbackX, m_knockbackY;
+    std::vector<Uint32> m_knockbackEndTime;
+    
+    // Cold data
+    std::vector<float> m_speed;
+    std::vector<int> m_originalLevel;
+    std::vector<Uint32> m_spawnTime;
+    std::vector<Uint64> m_lastStepTick;
+    std::vector<Uint8> m_stepPhase;
+};
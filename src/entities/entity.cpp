@@ -1,25 +1,21 @@
 #include "entity.h"
 #include <cmath>
 
-Entity::Entity() : m_x(0), m_y(0), m_active(false) {
-}
-
-Entity::~Entity() {
+Entity::Entity(int size) : m_x(0), m_y(0), m_prevX(0), m_prevY(0), m_subX(0.0f), m_subY(0.0f), m_size(size), m_active(false) {
 }
 
 void Entity::initialize(int x, int y) {
     m_x = x;
     m_y = y;
+    m_prevX = x;
+    m_prevY = y;
+    m_subX = 0.0f;
+    m_subY = 0.0f;
     m_active = true;
 }
 
-bool Entity::checkCollision(const SDL_Rect& otherRect) const {
-    SDL_Rect thisRect = getRect();
-    return rectsOverlap(thisRect, otherRect);
-}
-
-bool Entity::checkCollision(const Entity& other) const {
-    return checkCollision(other.getRect());
+SDL_Rect Entity::getRenderRect(float alpha) const {
+    return {interpolatePosition(m_prevX, m_x, alpha), interpolatePosition(m_prevY, m_y, alpha), m_size, m_size};
 }
 
 float Entity::distanceTo(int x, int y) const {
@@ -31,7 +27,3 @@ float Entity::distanceTo(int x, int y) const {
 float Entity::distanceTo(const Entity& other) const {
     return distanceTo(other.getCenterX(), other.getCenterY());
 }
-
-bool Entity::rectsOverlap(const SDL_Rect& a, const SDL_Rect& b) const {
-    return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h && a.y + a.h > b.y);
-}
@@ -1,48 +1,76 @@
 #pragma once
 #include <SDL.h>
+#include <cmath>
+#include "../systems/frame_clock.h"
+#include "../utils/subpixel.h"
 
+// Blend between the position at the start of the last simulation tick and the
+// current one; alpha is how far the renderer is into the next tick (0..1)
+inline int interpolatePosition(int previous, int current, float alpha) {
+    return previous + static_cast<int>(std::lround((current - previous) * alpha));
+}
+
+// Shared position, size and collision state for the player and the pet.
+// There is no virtual dispatch: the size is stored rather than asked of the
+// derived class, so getRect, the centre getters and checkCollision are plain
+// inline loads on the collision paths. Derived classes provide their own
+// (non-virtual) update and render; entities are never handled through an
+// Entity pointer.
 class Entity {
 public:
-    Entity();
-    virtual ~Entity();
-    
     // Initialize entity with position
-    virtual void initialize(int x, int y);
-    
-    // Update entity state (pure virtual - must be implemented by derived classes)
-    virtual void update() = 0;
-    
-    // Render entity (pure virtual - must be implemented by derived classes)
-    virtual void render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY) const = 0;
+    void initialize(int x, int y);
     
     // Getters
     int getX() const { return m_x; }
     int getY() const { return m_y; }
-    int getCenterX() const { return m_x + getSize() / 2; }
-    int getCenterY() const { return m_y + getSize() / 2; }
+    int getSize() const { return m_size; }
+    int getCenterX() const { return m_x + m_size / 2; }
+    int getCenterY() const { return m_y + m_size / 2; }
     bool isActive() const { return m_active; }
-    SDL_Rect getRect() const { return {m_x, m_y, getSize(), getSize()}; }
+    SDL_Rect getRect() const { return {m_x, m_y, m_size, m_size}; }
+    
+    // Interpolated position for rendering
+    SDL_Rect getRenderRect(float alpha) const;
+    int getRenderCenterX(float alpha) const { return interpolatePosition(m_prevX, m_x, alpha) + m_size / 2; }
+    int getRenderCenterY(float alpha) const { return interpolatePosition(m_prevY, m_y, alpha) + m_size / 2; }
+    
+    // Remember the current position as the start of the next tick
+    void savePreviousPosition() { m_prevX = m_x; m_prevY = m_y; }
     
     // Setters
-    void setPosition(int x, int y) { m_x = x; m_y = y; }
+    void setPosition(int x, int y) { m_x = x; m_y = y; m_subX = 0.0f; m_subY = 0.0f; }
     void setActive(bool active) { m_active = active; }
     
     // Collision detection
-    bool checkCollision(const SDL_Rect& otherRect) const;
-    bool checkCollision(const Entity& other) const;
+    bool checkCollision(const SDL_Rect& otherRect) const { return rectsOverlap(getRect(), otherRect); }
+    bool checkCollision(const Entity& other) const { return checkCollision(other.getRect()); }
     
     // Distance calculation
     float distanceTo(int x, int y) const;
     float distanceTo(const Entity& other) const;
     
-    // Virtual getter for size (must be implemented by derived classes)
-    virtual int getSize() const = 0;
-    
 protected:
+    // Only derived classes are constructed or destroyed, never through an Entity pointer
+    explicit Entity(int size);
+    ~Entity() = default;
+    
+    // Move by a sub-pixel amount; the fraction short of a whole pixel is
+    // carried to the next move instead of being truncated away
+    void moveBy(float dx, float dy) {
+        m_x = moveSubpixel(m_x, m_subX, dx);
+        m_y = moveSubpixel(m_y, m_subY, dy);
+    }
+    
     // Position and state
     int m_x, m_y;
+    int m_prevX, m_prevY;
+    float m_subX, m_subY; // Fraction of a pixel moved but not yet applied to m_x/m_y
+    int m_size;
     bool m_active;
     
     // Helper method for collision detection
-    bool rectsOverlap(const SDL_Rect& a, const SDL_Rect& b) const;
+    static bool rectsOverlap(const SDL_Rect& a, const SDL_Rect& b) {
+        return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h && a.y + a.h > b.y);
+    }
 };
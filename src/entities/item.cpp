@@ -1,88 +1,51 @@
 #include "item.h"
-#include <cmath>
-#include <algorithm>
+#include "entity.h"
+#include "../utils/simd_kernels.h"
+#include "../rendering/sprite_batch.h"
 
-Item::Item() 
-    : m_x(0), m_y(0), m_active(false), m_type(ItemType::SHARD), 
-      m_spawnTime(0), m_value(0), m_color({255, 255, 0, 255}) {
-}
-
-void Item::initialize(int x, int y, ItemType type, Uint32 spawnTime, int value, SDL_Color color) {
-    m_x = x;
-    m_y = y;
-    m_type = type;
-    m_spawnTime = spawnTime;
-    m_value = value;
-    m_color = color;
-    m_active = true;
-}
-
-void Item::update(int playerCenterX, int playerCenterY, Uint32 currentTime, bool magnetEffectActive) {
-    if (!m_active) return;
+void Item::applyMagnetPull(ItemStore& items, int playerCenterX, int playerCenterY, float stepScale) {
+    if (items.empty()) return;
     
-    // Move towards player if magnet effect is active (only for shards)
-    if (m_type == ItemType::SHARD && magnetEffectActive) {
-        moveTowardsPlayer(playerCenterX, playerCenterY);
-    }
-}
-
-void Item::render(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY) const {
-    if (!m_active) return;
+    // Shards are all the same size, so moving their corners toward the player's
+    // centre less half a shard moves their centres toward the player's centre
+    pullTowardsTarget(items.getXData(), items.getYData(), items.getMagneticData(), items.size(),
+                      static_cast<float>(playerCenterX - SHARD_SIZE / 2),
+                      static_cast<float>(playerCenterY - SHARD_SIZE / 2),
+                      MAGNET_PULL_SPEED * stepScale);
+    items.markMoved();
+}
+
+void Item::render(const ItemStore& items, int index, SpriteBatch& batch, int cameraOffsetX, int cameraOffsetY,
+                  const FrameTime& time) {
+    if (!items.isActive(index)) return;
     
-    SDL_Rect destRect = {m_x + cameraOffsetX, m_y + cameraOffsetY, getSize(), getSize()};
+    int size = items.getSize(index);
+    SDL_Rect destRect = {interpolatePosition(items.getPrevX(index), items.getX(index), time.alpha) + cameraOffsetX,
+                         interpolatePosition(items.getPrevY(index), items.getY(index), time.alpha) + cameraOffsetY,
+                         size, size};
     
-    if (m_type == ItemType::SHARD) {
+    if (items.getType(index) == ItemType::SHARD) {
         // Render shard with its color
-        SDL_SetRenderDrawColor(renderer, m_color.r, m_color.g, m_color.b, m_color.a);
+        batch.fillRect(destRect, items.getColor(index));
     } else {
         // Render magnet with cyan color
-        SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255);
+        batch.fillRect(destRect, {0, 255, 255, 255});
     }
-    
-    SDL_RenderFillRect(renderer, &destRect);
-}
-
-int Item::getSize() const {
-    return (m_type == ItemType::SHARD) ? SHARD_SIZE : MAGNET_SIZE;
 }
 
-bool Item::checkCollision(const SDL_Rect& otherRect) const {
-    if (!m_active) return false;
-    SDL_Rect myRect = getRect();
-    return SDL_HasIntersection(&myRect, &otherRect);
-}
-
-bool Item::checkCollisionWithPlayer(const SDL_Rect& playerRect) const {
-    if (!m_active) return false;
-    return checkCollision(playerRect);
-}
-
-void Item::moveTowardsPlayer(int playerCenterX, int playerCenterY) {
-    float dx = playerCenterX - getCenterX();
-    float dy = playerCenterY - getCenterY();
-    float distance = sqrt(dx * dx + dy * dy);
+bool Item::handleCollection(ItemStore& items, int index, const SDL_Rect& playerRect, Uint32 currentTime,
+                            int& playerScore, Uint32& magnetEffectEndTime) {
+    if (!items.isActive(index)) return false;
     
-    if (distance > 0) {
-        // Normalize direction and move towards player
-        dx /= distance;
-        dy /= distance;
-        m_x += dx * 3.0f; // Shard speed towards player
-        m_y += dy * 3.0f;
-    }
-}
-
-bool Item::handleCollection(const SDL_Rect& playerRect, Uint32 currentTime, int& playerScore, Uint32& magnetEffectEndTime) {
-    if (!isActive() || !checkCollisionWithPlayer(playerRect)) {
-        return false;
-    }
+    SDL_Rect itemRect = items.getRect(index);
+    if (!SDL_HasIntersection(&itemRect, &playerRect)) return false;
     
-    if (m_type == ItemType::SHARD) {
-        playerScore += m_value;
-    } else if (m_type == ItemType::MAGNET) {
-        magnetEffectEndTime = currentTime + 20000; // 20 seconds
+    if (items.getType(index) == ItemType::SHARD) {
+        playerScore += items.getValue(index);
+    } else {
+        magnetEffectEndTime = currentTime + MAGNET_DURATION;
     }
     
-    setActive(false);
+    items.setActive(index, false);
     return true;
 }
-
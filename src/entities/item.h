@@ -1,69 +1,38 @@
 #pragma once
 #include <SDL.h>
+#include "item_store.h"
+#include "../systems/frame_clock.h"
 
-enum class ItemType {
-    SHARD,
-    MAGNET
-};
+class SpriteBatch;
 
+// Item behaviour and tuning. Per-item state lives in ItemStore; these
+// functions operate on one item of the store, or on all of them at once.
 class Item {
 public:
-    // Constructor
-    Item();
-    
-    // Initialize item with position and properties
-    void initialize(int x, int y, ItemType type, Uint32 spawnTime, int value = 0, SDL_Color color = {255, 255, 0, 255});
-    
-    // Update item state (movement, lifetime, etc.)
-    void update(int playerCenterX, int playerCenterY, Uint32 currentTime, bool magnetEffectActive);
-    
-    // Render the item
-    void render(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY) const;
-    
-    // Getters
-    int getX() const { return m_x; }
-    int getY() const { return m_y; }
-    int getCenterX() const { return m_x + getSize() / 2; }
-    int getCenterY() const { return m_y + getSize() / 2; }
-    int getSize() const;
-    ItemType getType() const { return m_type; }
-    bool isActive() const { return m_active; }
-    int getValue() const { return m_value; }
-    SDL_Color getColor() const { return m_color; }
-    SDL_Rect getRect() const { return {m_x, m_y, getSize(), getSize()}; }
+    // Pull every shard toward the player while the magnet effect is active
+    // (one batched pass over the store's positions)
+    static void applyMagnetPull(ItemStore& items, int playerCenterX, int playerCenterY, float stepScale);
     
-    // Setters
-    void setPosition(int x, int y) { m_x = x; m_y = y; }
-    void setActive(bool active) { m_active = active; }
+    // Render the item (time.alpha interpolates between the previous and current tick positions)
+    static void render(const ItemStore& items, int index, SpriteBatch& batch, int cameraOffsetX, int cameraOffsetY,
+                       const FrameTime& time);
     
-    // Collision detection
-    bool checkCollision(const SDL_Rect& otherRect) const;
-    bool checkCollisionWithPlayer(const SDL_Rect& playerRect) const;
+    // Collect an item the player touches: shards add to the score, magnets
+    // start the magnet effect. Returns true if the item was collected.
+    static bool handleCollection(ItemStore& items, int index, const SDL_Rect& playerRect, Uint32 currentTime,
+                                 int& playerScore, Uint32& magnetEffectEndTime);
     
-    // Collection handling
-    bool handleCollection(const SDL_Rect& playerRect, Uint32 currentTime, int& playerScore, Uint32& magnetEffectEndTime);
+    static int getSize(ItemType type) { return (type == ItemType::SHARD) ? SHARD_SIZE : MAGNET_SIZE; }
     
     // Static constants
     static constexpr int SHARD_SIZE = 8;
     static constexpr int MAGNET_SIZE = 12;
+    static constexpr float MAGNET_PULL_SPEED = 3.0f;
+    static constexpr Uint32 MAGNET_DURATION = 20000; // milliseconds
     static constexpr int MAX_SHARDS = 50;
     static constexpr int MAX_MAGNETS = 5;
     static constexpr int MAGNET_DROP_CHANCE = 1; // 1 in 100 chance
-    
-private:
-    // Position
-    int m_x, m_y;
-    
-    // State
-    bool m_active;
-    ItemType m_type;
-    Uint32 m_spawnTime;
-    
-    // Item-specific properties
-    int m_value;
-    SDL_Color m_color;
-    
-    // Helper methods
-    void moveTowardsPlayer(int playerCenterX, int playerCenterY);
-    bool isExpired(Uint32 currentTime) const;
+    // Item store capacity; while it is full, a dropped shard's value goes to
+    // the nearest shard and magnet drops are skipped
+    static constexpr int MAX_ITEMS = 512;
 };
@@ -0,0 +1,192 @@
+#include "item_store.h"
+#include "item.h"
+#include <algorithm>
+
+ItemStore::ItemStore() : m_capacity(0), m_highWater(0), m_failedAdds(0), m_indexDirty(true) {
+}
+
+ItemStore::~ItemStore() {
+    // Cleanup handled by vector destructors
+}
+
+void ItemStore::initialize(int capacity) {
+    m_capacity = capacity;
+    m_x.reserve(capacity);
+    m_y.reserve(capacity);
+    m_prevX.reserve(capacity);
+    m_prevY.reserve(capacity);
+    m_size.reserve(capacity);
+    m_active.reserve(capacity);
+    m_magnetic.reserve(capacity);
+    m_type.reserve(capacity);
+    m_value.reserve(capacity);
+    m_color.reserve(capacity);
+    m_spawnTime.reserve(capacity);
+    m_retired.reserve(capacity);
+    m_grid.initialize(INDEX_CELL_SIZE, capacity);
+    
+    clear();
+    m_highWater = 0;
+    m_failedAdds = 0;
+}
+
+void ItemStore::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_prevX.clear();
+    m_prevY.clear();
+    m_size.clear();
+    m_active.clear();
+    m_magnetic.clear();
+    m_type.clear();
+    m_value.clear();
+    m_color.clear();
+    m_spawnTime.clear();
+    m_retired.clear();
+    m_indexDirty = true;
+}
+
+int ItemStore::add(int x, int y, ItemType type, Uint32 spawnTime, int value, SDL_Color color) {
+    if (size() >= m_capacity) {
+        m_failedAdds++;
+        return -1;
+    }
+    
+    m_x.push_back(static_cast<float>(x));
+    m_y.push_back(static_cast<float>(y));
+    m_prevX.push_back(static_cast<float>(x));
+    m_prevY.push_back(static_cast<float>(y));
+    m_size.push_back(Item::getSize(type));
+    m_active.push_back(1);
+    m_magnetic.push_back(type == ItemType::SHARD ? 1 : 0);
+    m_type.push_back(static_cast<Uint8>(type));
+    m_value.push_back(value);
+    m_color.push_back(color);
+    m_spawnTime.push_back(spawnTime);
+    m_indexDirty = true;
+    
+    m_highWater = std::max(m_highWater, size());
+    return size() - 1;
+}
+
+int ItemStore::getActiveCount() const {
+    int count = 0;
+    for (Uint8 active : m_active) {
+        count += active;
+    }
+    return count;
+}
+
+void ItemStore::setActive(int i, bool active) {
+    if (m_active[i] && !active) {
+        m_retired.push_back(i);
+    }
+    m_active[i] = active ? 1 : 0;
+    m_magnetic[i] = (active && getType(i) == ItemType::SHARD) ? 1 : 0;
+}
+
+void ItemStore::removeInactive() {
+    if (m_retired.empty()) return;
+    
+    // Highest index first: everything above the one being removed is then
+    // live, so the last item can be moved into its slot. An item may be
+    // listed twice (deactivated, reactivated, deactivated) or be live again.
+    std::sort(m_retired.begin(), m_retired.end(), [](int a, int b) { return a > b; });
+    m_retired.erase(std::unique(m_retired.begin(), m_retired.end()), m_retired.end());
+    for (int i : m_retired) {
+        if (m_active[i]) continue;
+        
+        int last = size() - 1;
+        if (i != last) {
+            m_x[i] = m_x[last];
+            m_y[i] = m_y[last];
+            m_prevX[i] = m_prevX[last];
+            m_prevY[i] = m_prevY[last];
+            m_size[i] = m_size[last];
+            m_active[i] = m_active[last];
+            m_magnetic[i] = m_magnetic[last];
+            m_type[i] = m_type[last];
+            m_value[i] = m_value[last];
+            m_color[i] = m_color[last];
+            m_spawnTime[i] = m_spawnTime[last];
+        }
+        m_x.pop_back();
+        m_y.pop_back();
+        m_prevX.pop_back();
+        m_prevY.pop_back();
+        m_size.pop_back();
+        m_active.pop_back();
+        m_magnetic.pop_back();
+        m_type.pop_back();
+        m_value.pop_back();
+        m_color.pop_back();
+        m_spawnTime.pop_back();
+        m_indexDirty = true;
+    }
+    m_retired.clear();
+}
+
+void ItemStore::snapshotPositions() {
+    m_prevX.assign(m_x.begin(), m_x.end());
+    m_prevY.assign(m_y.begin(), m_y.end());
+}
+
+void ItemStore::refreshIndex() {
+    if (!m_indexDirty || size() < MIN_INDEXED_ITEMS) return;
+    
+    // Items are bucketed by their top-left corner
+    m_grid.clear();
+    for (int i = 0; i < size(); i++) {
+        if (m_active[i]) {
+            m_grid.insert(i, getX(i), getY(i));
+        }
+    }
+    m_grid.build();
+    m_indexDirty = false;
+}
+
+void ItemStore::queryRect(const SDL_Rect& rect, std::vector<int>& out) const {
+    out.clear();
+    if (rect.w <= 0 || rect.h <= 0) return;
+    
+    if (size() < MIN_INDEXED_ITEMS) {
+        for (int i = 0; i < size(); i++) {
+            SDL_Rect itemRect = getRect(i);
+            if (m_active[i] && SDL_HasIntersection(&itemRect, &rect)) {
+                out.push_back(i);
+            }
+        }
+        return;
+    }
+    
+    // An item overlapping rect has its corner at most one item size up and left of it
+    int reach = std::max(Item::SHARD_SIZE, Item::MAGNET_SIZE);
+    m_grid.queryArea(rect.x - reach, rect.y - reach, rect.x + rect.w - 1, rect.y + rect.h - 1, out);
+    
+    size_t kept = 0;
+    for (int i : out) {
+        SDL_Rect itemRect = getRect(i);
+        if (m_active[i] && SDL_HasIntersection(&itemRect, &rect)) {
+            out[kept++] = i;
+        }
+    }
+    out.resize(kept);
+    std::sort(out.begin(), out.end());
+}
+
+int ItemStore::findNearestShard(int x, int y) const {
+    int nearest = -1;
+    long long nearestDistance = 0;
+    for (int i = 0; i < size(); i++) {
+        if (!m_active[i] || getType(i) != ItemType::SHARD) continue;
+        
+        long long dx = getCenterX(i) - x;
+        long long dy = getCenterY(i) - y;
+        long long distance = dx * dx + dy * dy;
+        if (nearest < 0 || distance < nearestDistance) {
+            nearest = i;
+            nearestDistance = distance;
+        }
+    }
+    return nearest;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "../systems/spatial_grid.h"
+#include "../utils/subpixel.h"
+
+enum class ItemType {
+    SHARD,
+    MAGNET
+};
+
+// Structure-of-arrays storage for every item on the ground.
+// Positions sit in their own (sub-pixel) float arrays so the magnet pull can
+// run as one vectorized pass over them; getters return whole pixels.
+// Capacity is fixed: add() refuses new items once it is reached, and
+// removeInactive() drops dead ones. A cell index over item positions lets
+// collection test only the items near the player.
+class ItemStore {
+public:
+    ItemStore();
+    ~ItemStore();
+    
+    // Allocate storage for capacity items (drops any live ones)
+    void initialize(int capacity);
+    void clear();
+    int size() const { return static_cast<int>(m_x.size()); }
+    bool empty() const { return m_x.empty(); }
+    int getActiveCount() const;
+    
+    // Add a new active item and return its index, or -1 if the store is full
+    int add(int x, int y, ItemType type, Uint32 spawnTime, int value = 0, SDL_Color color = {255, 255, 0, 255});
+    
+    // Remove the items deactivated since the last call. Each one's slot is
+    // refilled from the end of the store, so the cost is per removed item
+    // (not per live one) and order is not drop order.
+    void removeInactive();
+    
+    // Copy current positions into the previous-tick buffer (for render interpolation)
+    void snapshotPositions();
+    
+    // Getters
+    int getX(int i) const { return toPixel(m_x[i]); }
+    int getY(int i) const { return toPixel(m_y[i]); }
+    int getPrevX(int i) const { return toPixel(m_prevX[i]); }
+    int getPrevY(int i) const { return toPixel(m_prevY[i]); }
+    int getSize(int i) const { return m_size[i]; }
+    int getCenterX(int i) const { return getX(i) + m_size[i] / 2; }
+    int getCenterY(int i) const { return getY(i) + m_size[i] / 2; }
+    SDL_Rect getRect(int i) const { return {getX(i), getY(i), m_size[i], m_size[i]}; }
+    ItemType getType(int i) const { return static_cast<ItemType>(m_type[i]); }
+    bool isActive(int i) const { return m_active[i] != 0; }
+    int getValue(int i) const { return m_value[i]; }
+    SDL_Color getColor(int i) const { return m_color[i]; }
+    Uint32 getSpawnTime(int i) const { return m_spawnTime[i]; }
+    
+    // Setters
+    void setPosition(int i, int x, int y) {
+        m_x[i] = static_cast<float>(x);
+        m_y[i] = static_cast<float>(y);
+        m_indexDirty = true;
+    }
+    void setActive(int i, bool active);
+    void setValue(int i, int value) { m_value[i] = value; }
+    
+    // Raw position arrays and the per-item "pulled by magnets" flags (active
+    // shards), for batch kernels. Call markMoved() after writing positions.
+    float* getXData() { return m_x.data(); }
+    float* getYData() { return m_y.data(); }
+    const Uint8* getMagneticData() const { return m_magnetic.data(); }
+    void markMoved() { m_indexDirty = true; }
+    
+    // Cell index over item positions; refreshIndex() rebuilds it only if
+    // items were added, removed or moved since the last refresh. Small stores
+    // (the usual case with shard coalescing) skip the index and scan instead.
+    void refreshIndex();
+    
+    // Active items whose rect intersects rect (same rule as SDL_HasIntersection),
+    // in index order. The index must be fresh.
+    void queryRect(const SDL_Rect& rect, std::vector<int>& out) const;
+    
+    // Active shard whose centre is nearest (x, y), lowest index on ties, or
+    // -1 if there is none. A linear scan: meant for the rare full-store case.
+    int findNearestShard(int x, int y) const;
+    
+    // Counters
+    int getCapacity() const { return m_capacity; }
+    int getHighWater() const { return m_highWater; }
+    int getFailedAdds() const { return m_failedAdds; }
+    void resetCounters() { m_highWater = size(); m_failedAdds = 0; }
+
+private:
+    // Hot data
+    std::vector<float> m_x, m_y;
+    std::vector<float> m_prevX, m_prevY;
+    std::vector<int> m_size;
+    std::vector<Uint8> m_active;
+    std::vector<Uint8> m_magnetic;
+    
+    // Cold data
+    std::vector<Uint8> m_type;
+    std::vector<int> m_value;
+    std::vector<SDL_Color> m_color;
+    std::vector<Uint32> m_spawnTime;
+    
+    std::vector<int> m_retired; // Deactivated since the last removeInactive()
+    
+    int m_capacity;
+    int m_highWater;
+    int m_failedAdds;
+    
+    // Cell index
+    SpatialGrid m_grid;
+    bool m_indexDirty;
+    static constexpr int INDEX_CELL_SIZE = 64;
+    static constexpr int MIN_INDEXED_ITEMS = 128; // Below this a linear scan is cheaper than a rebuild
+};
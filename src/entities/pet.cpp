@@ -1,41 +1,35 @@
 #include "pet.h"
 #include "player.h"
-#include "enemy.h"
+#include "../systems/collision_world.h"
+#include "../systems/projectile_system.h"
+#include "../rendering/sprite_batch.h"
 #include <cmath>
 #include <algorithm>
 
-Pet::Pet() : m_lastShotTime(0) {
-    m_projectiles.reserve(20); // Reserve space for projectiles
+Pet::Pet() : Entity(SIZE), m_lastShotTime(0) {
 }
 
 Pet::~Pet() {
-    // Cleanup handled by vector destructor
+    // No dynamic memory to clean up
 }
 
 void Pet::initialize(int startX, int startY) {
     Entity::initialize(startX, startY);
     m_lastShotTime = 0;
-    m_projectiles.clear();
 }
 
-void Pet::update() {
-    // Basic update - can be overridden by specific update methods
-}
-
-void Pet::update(const Player& player, const std::vector<Enemy>& enemies, Uint32 currentTime) {
+void Pet::update(const Player& player, const CollisionWorld& collisionWorld, const EnemyStore& enemies,
+                 ProjectileSystem& projectiles, const FrameTime& time) {
     if (!m_active) return;
     
     // Follow the player
-    followPlayer(player);
+    followPlayer(player, time.stepScale);
     
     // Find and shoot at nearest enemy
-    findAndShootNearestEnemy(enemies, currentTime);
-    
-    // Update projectiles
-    updateProjectiles(currentTime);
+    findAndShootNearestEnemy(collisionWorld, enemies, projectiles, time.simTime);
 }
 
-void Pet::followPlayer(const Player& player) {
+void Pet::followPlayer(const Player& player, float stepScale) {
     int playerCenterX = player.getCenterX();
     int playerCenterY = player.getCenterY();
     int petCenterX = getCenterX();
@@ -50,156 +44,61 @@ void Pet::followPlayer(const Player& player) {
     if (distance > FOLLOW_DISTANCE) {
         // Normalize direction and move towards player
         if (distance > 0) {
-            float moveX = (dx / distance) * 5.0f; // Increased pet speed from 3.0f to 5.0f
-            float moveY = (dy / distance) * 5.0f;
-            
-            m_x += static_cast<int>(moveX);
-            m_y += static_cast<int>(moveY);
+            float moveX = (dx / distance) * 5.0f * stepScale; // Increased pet speed from 3.0f to 5.0f
+            float moveY = (dy / distance) * 5.0f * stepScale;
+            moveBy(moveX, moveY);
         }
     }
 }
 
-void Pet::findAndShootNearestEnemy(const std::vector<Enemy>& enemies, Uint32 currentTime) {
+void Pet::findAndShootNearestEnemy(const CollisionWorld& collisionWorld, const EnemyStore& enemies,
+                                   ProjectileSystem& projectiles, Uint32 currentTime) {
     // Check if we can shoot (cooldown)
     if (currentTime - m_lastShotTime < SHOOT_COOLDOWN) {
         return;
     }
     
-    float nearestDistance = DETECTION_RANGE;
-    int nearestEnemyIndex = -1;
-    
     // Find nearest enemy within detection range
-    for (size_t i = 0; i < enemies.size(); i++) {
-        if (!enemies[i].isActive()) continue;
-        
-        float distance = distanceTo(enemies[i].getCenterX(), enemies[i].getCenterY());
-        if (distance < nearestDistance) {
-            nearestDistance = distance;
-            nearestEnemyIndex = static_cast<int>(i);
-        }
-    }
+    int nearestEnemyIndex = collisionWorld.nearest(getCenterX(), getCenterY(), DETECTION_RANGE);
     
     // Shoot at nearest enemy if found
     if (nearestEnemyIndex >= 0) {
-        shootAt(enemies[nearestEnemyIndex].getCenterX(), 
-                enemies[nearestEnemyIndex].getCenterY(), 
+        shootAt(enemies.getCenterX(nearestEnemyIndex), 
+                enemies.getCenterY(nearestEnemyIndex), 
+                projectiles,
                 currentTime);
     }
 }
 
-void Pet::shootAt(int targetX, int targetY, Uint32 currentTime) {
+void Pet::shootAt(int targetX, int targetY, ProjectileSystem& projectiles, Uint32 currentTime) {
     // Calculate direction to target
     float dx = targetX - getCenterX();
     float dy = targetY - getCenterY();
     float distance = sqrt(dx * dx + dy * dy);
     
     if (distance > 0) {
-        // Normalize direction
-        float velocityX = (dx / distance) * Projectile::SPEED;
-        float velocityY = (dy / distance) * Projectile::SPEED;
-        
-        // Create new projectile
-        Projectile projectile;
-        projectile.active = true;
-        projectile.x = getCenterX() - Projectile::SIZE / 2;
-        projectile.y = getCenterY() - Projectile::SIZE / 2;
-        projectile.velocityX = velocityX;
-        projectile.velocityY = velocityY;
-        projectile.spawnTime = currentTime;
-        
-        m_projectiles.push_back(projectile);
-        m_lastShotTime = currentTime;
-    }
-}
-
-float Pet::distanceTo(int x, int y) const {
-    float dx = x - getCenterX();
-    float dy = y - getCenterY();
-    return sqrt(dx * dx + dy * dy);
-}
-
-void Pet::updateProjectiles(Uint32 currentTime) {
-    for (auto& projectile : m_projectiles) {
-        if (!projectile.active) continue;
-        
-        // Check lifetime
-        if (currentTime - projectile.spawnTime > Projectile::LIFETIME) {
-            projectile.active = false;
-            continue;
+        // Launch from the pet's centre along the normalized direction
+        int size = ProjectileSystem::getTypeInfo(ProjectileType::PET_BOLT).size;
+        if (projectiles.spawn(ProjectileType::PET_BOLT, getCenterX() - size / 2, getCenterY() - size / 2,
+                              dx / distance, dy / distance, currentTime) < 0) {
+            return; // Projectile store full
         }
         
-        // Update position
-        projectile.x += static_cast<int>(projectile.velocityX);
-        projectile.y += static_cast<int>(projectile.velocityY);
+        m_lastShotTime = currentTime;
     }
-    
-    // Remove inactive projectiles
-    m_projectiles.erase(
-        std::remove_if(m_projectiles.begin(), m_projectiles.end(),
-            [](const Projectile& p) { return !p.active; }),
-        m_projectiles.end()
-    );
 }
 
-void Pet::render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY) const {
+void Pet::render(SpriteBatch& batch, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY, const FrameTime& time) const {
     if (!m_active) return;
     
-    SDL_Rect petRect = getRect();
+    SDL_Rect petRect = getRenderRect(time.alpha);
     petRect.x += cameraOffsetX;
     petRect.y += cameraOffsetY;
     
     if (texture) {
-        SDL_RenderCopy(renderer, texture, NULL, &petRect);
+        batch.draw(texture, nullptr, petRect);
     } else {
         // Fallback: draw a colored rectangle
-        SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255); // Cyan color for pet
-        SDL_RenderFillRect(renderer, &petRect);
-    }
-}
-
-void Pet::renderProjectiles(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY) const {
-    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow projectiles
-    
-    for (const auto& projectile : m_projectiles) {
-        if (!projectile.active) continue;
-        
-        SDL_Rect projectileRect = {
-            projectile.x + cameraOffsetX,
-            projectile.y + cameraOffsetY,
-            Projectile::SIZE,
-            Projectile::SIZE
-        };
-        
-        SDL_RenderFillRect(renderer, &projectileRect);
-    }
-}
-
-void Pet::handleProjectileCollisions(std::vector<Enemy>& enemies, std::vector<Item>& items, Uint32 currentTime) {
-    for (const auto& projectile : m_projectiles) {
-        if (!projectile.active) continue;
-        
-        SDL_Rect projectileRect = {projectile.x, projectile.y, Projectile::SIZE, Projectile::SIZE};
-        
-        for (auto& enemy : enemies) {
-            if (enemy.isActive() && enemy.checkCollision(projectileRect)) {
-                // Enemy hit by pet projectile
-                enemy.takeDamage();
-                
-                // Calculate knockback direction
-                float dx = enemy.getX() - m_x;
-                float dy = enemy.getY() - m_y;
-                float distance = sqrt(dx * dx + dy * dy);
-                enemy.applyKnockback(dx, dy, distance, currentTime);
-                
-                // Handle enemy death and item drops
-                if (!enemy.isActive()) {
-                    enemy.handleDeath(items, currentTime);
-                }
-                
-                // Mark projectile as inactive
-                const_cast<Projectile&>(projectile).active = false;
-                break;
-            }
-        }
+        batch.fillRect(petRect, {0, 255, 255, 255}); // Cyan color for pet
     }
 }
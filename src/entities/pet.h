@@ -2,21 +2,13 @@
 #include <SDL.h>
 #include <vector>
 #include "entity.h"
+#include "enemy_store.h"
 
 // Forward declarations
 class Player;
-class Enemy;
-class Item;
-
-struct Projectile {
-    bool active;
-    int x, y;
-    float velocityX, velocityY;
-    Uint32 spawnTime;
-    static const int SIZE = 4;
-    static const int SPEED = 8;
-    static const int LIFETIME = 2000; // 2 seconds
-};
+class CollisionWorld;
+class ProjectileSystem;
+class SpriteBatch;
 
 class Pet : public Entity {
 public:
@@ -27,22 +19,13 @@ public:
     void initialize(int startX, int startY);
     
     // Update pet state
-    void update() override;
-    void update(const Player& player, const std::vector<Enemy>& enemies, Uint32 currentTime);
+    // Targets come from collisionWorld, which must have been rebuilt after the enemies last moved;
+    // shots are launched into projectiles
+    void update(const Player& player, const CollisionWorld& collisionWorld, const EnemyStore& enemies,
+                ProjectileSystem& projectiles, const FrameTime& time);
     
     // Render the pet
-    void render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY) const override;
-    
-    // Entity interface
-    int getSize() const override { return SIZE; }
-    
-    // Projectile management
-    const std::vector<Projectile>& getProjectiles() const { return m_projectiles; }
-    void updateProjectiles(Uint32 currentTime);
-    void renderProjectiles(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY) const;
-    
-    // Collision handling
-    void handleProjectileCollisions(std::vector<Enemy>& enemies, std::vector<Item>& items, Uint32 currentTime);
+    void render(SpriteBatch& batch, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY, const FrameTime& time) const;
     
     // Constants
     static const int SIZE = 12;
@@ -53,12 +36,11 @@ public:
 private:
     
     // Shooting
-    std::vector<Projectile> m_projectiles;
     Uint32 m_lastShotTime;
     
     // Helper methods
-    void followPlayer(const Player& player);
-    void findAndShootNearestEnemy(const std::vector<Enemy>& enemies, Uint32 currentTime);
-    void shootAt(int targetX, int targetY, Uint32 currentTime);
-    float distanceTo(int x, int y) const;
+    void followPlayer(const Player& player, float stepScale);
+    void findAndShootNearestEnemy(const CollisionWorld& collisionWorld, const EnemyStore& enemies,
+                                  ProjectileSystem& projectiles, Uint32 currentTime);
+    void shootAt(int targetX, int targetY, ProjectileSystem& projectiles, Uint32 currentTime);
 };
@@ -1,9 +1,12 @@
 #include "player.h"
+#include "../systems/projectile_system.h"
+#include "../rendering/sprite_batch.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
 
-Player::Player() : m_dir(DOWN), m_alive(true), m_score(0), m_characterClass(CharacterClass::SWORDSMAN) {
+Player::Player()
+    : Entity(PLAYER_SIZE), m_dir(DOWN), m_alive(true), m_score(0), m_characterClass(CharacterClass::SWORDSMAN), m_projectiles(nullptr) {
     m_attack = {false, {0, 0, PLAYER_SIZE, PLAYER_SIZE}, 0};
 }
 
@@ -19,30 +22,26 @@ void Player::initialize(int startX, int startY) {
     m_score = 0;
 }
 
-void Player::update() {
+void Player::update(const FrameTime& time) {
     // Update attack state
-    if (m_attack.active && SDL_GetTicks() - m_attack.startTime > ATTACK_DURATION) {
+    if (m_attack.active && time.simTime - m_attack.startTime > ATTACK_DURATION) {
         m_attack.active = false;
     }
-    
-    // Update projectiles
-    updateProjectiles();
 }
 
-void Player::render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY) const {
-    SDL_Rect playerRect = getRect();
+void Player::render(SpriteBatch& batch, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY, const FrameTime& time) const {
+    SDL_Rect playerRect = getRenderRect(time.alpha);
     playerRect.x += cameraOffsetX;
     playerRect.y += cameraOffsetY;
     
     if (texture) {
-        SDL_RenderCopy(renderer, texture, NULL, &playerRect);
+        batch.draw(texture, nullptr, playerRect);
     } else {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        SDL_RenderFillRect(renderer, &playerRect);
+        batch.fillRect(playerRect, {255, 255, 255, 255});
     }
 }
 
-void Player::handleInput(const Uint8* keystate) {
+void Player::handleInput(const Uint8* keystate, float stepScale) {
     float moveX = 0, moveY = 0;
     
     if (keystate[SDL_SCANCODE_W]) {
@@ -70,24 +69,23 @@ void Player::handleInput(const Uint8* keystate) {
     }
     
     // Apply movement
-    m_x += moveX * PLAYER_SPEED;
-    m_y += moveY * PLAYER_SPEED;
+    moveBy(moveX * PLAYER_SPEED * stepScale, moveY * PLAYER_SPEED * stepScale);
 }
 
-void Player::handleAttack() {
+void Player::handleAttack(const FrameTime& time) {
     // Handle different attack types based on character class
     switch (m_characterClass) {
         case CharacterClass::BOMBER:
-            handleBomberAttack();
+            handleBomberAttack(time);
             break;
         case CharacterClass::ARCHER:
-            handleArcherAttack();
+            handleArcherAttack(time);
             break;
         case CharacterClass::MAGE:
-            handleMageAttack();
+            handleMageAttack(time);
             break;
         case CharacterClass::SWORDSMAN:
-            handleSwordsmanAttack();
+            handleSwordsmanAttack(time);
             break;
     }
 }
@@ -100,6 +98,7 @@ void Player::handleDeath() {
 void Player::respawn(int worldWidth, int worldHeight) {
     // Reset position to world center
     setPosition(worldWidth / 2 - PLAYER_SIZE / 2, worldHeight / 2 - PLAYER_SIZE / 2);
+    savePreviousPosition(); // Don't interpolate across the map
     m_alive = true;
     m_score = 0;
     clearProjectiles();
@@ -110,121 +109,34 @@ void Player::setCharacterClass(CharacterClass characterClass) {
     clearProjectiles(); // Clear any existing projectiles when changing class
 }
 
-void Player::updateProjectiles() {
-    for (auto& projectile : m_projectiles) {
-        projectile.update();
-    }
-    
-    // Remove inactive projectiles
-    m_projectiles.erase(
-        std::remove_if(m_projectiles.begin(), m_projectiles.end(),
-            [](const PlayerProjectile& p) { return !p.isActive(); }),
-        m_projectiles.end()
-    );
-}
-
-void Player::renderProjectiles(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY) const {
-    for (const auto& projectile : m_projectiles) {
-        projectile.render(renderer, nullptr, cameraOffsetX, cameraOffsetY);
-        projectile.renderTimer(renderer, cameraOffsetX, cameraOffsetY);
-    }
-}
-
 void Player::clearProjectiles() {
-    m_projectiles.clear();
-}
-
-void Player::removeExplodedProjectiles() {
-    // Remove projectiles that have exploded and been processed
-    m_projectiles.erase(
-        std::remove_if(m_projectiles.begin(), m_projectiles.end(),
-            [](const PlayerProjectile& p) { return p.isExploded(); }),
-        m_projectiles.end()
-    );
+    if (m_projectiles) {
+        m_projectiles->clear(ProjectileOwner::PLAYER);
+    }
 }
 
-void Player::handleBomberAttack() {
-    // Create a bomb projectile
-    PlayerProjectile bomb;
-    float dirX = 0, dirY = 0;
-    
-    // Set direction based on player facing direction
-    switch (m_dir) {
-        case UP: dirY = -1; break;
-        case DOWN: dirY = 1; break;
-        case LEFT: dirX = -1; break;
-        case RIGHT: dirX = 1; break;
-    }
-    
-    // Normalize direction
-    float length = sqrt(dirX * dirX + dirY * dirY);
-    if (length > 0) {
-        dirX /= length;
-        dirY /= length;
-    }
-    
-    bomb.initialize(ProjectileType::BOMB, m_x + PLAYER_SIZE/2, m_y + PLAYER_SIZE/2, dirX, dirY);
-    m_projectiles.push_back(bomb);
+void Player::handleBomberAttack(const FrameTime& time) {
+    if (!launchProjectile(ProjectileType::BOMB, time)) return; // Projectile store full
     
     std::cout << "Bomber threw a bomb!" << std::endl;
 }
 
-void Player::handleArcherAttack() {
-    // Create an arrow projectile
-    PlayerProjectile arrow;
-    float dirX = 0, dirY = 0;
-    
-    // Set direction based on player facing direction
-    switch (m_dir) {
-        case UP: dirY = -1; break;
-        case DOWN: dirY = 1; break;
-        case LEFT: dirX = -1; break;
-        case RIGHT: dirX = 1; break;
-    }
-    
-    // Normalize direction
-    float length = sqrt(dirX * dirX + dirY * dirY);
-    if (length > 0) {
-        dirX /= length;
-        dirY /= length;
-    }
-    
-    arrow.initialize(ProjectileType::ARROW, m_x + PLAYER_SIZE/2, m_y + PLAYER_SIZE/2, dirX, dirY);
-    m_projectiles.push_back(arrow);
+void Player::handleArcherAttack(const FrameTime& time) {
+    if (!launchProjectile(ProjectileType::ARROW, time)) return; // Projectile store full
     
     std::cout << "Archer fired an arrow!" << std::endl;
 }
 
-void Player::handleMageAttack() {
-    // Create a fireball projectile
-    PlayerProjectile fireball;
-    float dirX = 0, dirY = 0;
-    
-    // Set direction based on player facing direction
-    switch (m_dir) {
-        case UP: dirY = -1; break;
-        case DOWN: dirY = 1; break;
-        case LEFT: dirX = -1; break;
-        case RIGHT: dirX = 1; break;
-    }
-    
-    // Normalize direction
-    float length = sqrt(dirX * dirX + dirY * dirY);
-    if (length > 0) {
-        dirX /= length;
-        dirY /= length;
-    }
-    
-    fireball.initialize(ProjectileType::FIREBALL, m_x + PLAYER_SIZE/2, m_y + PLAYER_SIZE/2, dirX, dirY);
-    m_projectiles.push_back(fireball);
+void Player::handleMageAttack(const FrameTime& time) {
+    if (!launchProjectile(ProjectileType::FIREBALL, time)) return; // Projectile store full
     
     std::cout << "Mage cast a fireball!" << std::endl;
 }
 
-void Player::handleSwordsmanAttack() {
+void Player::handleSwordsmanAttack(const FrameTime& time) {
     // Traditional melee attack
     m_attack.active = true;
-    m_attack.startTime = SDL_GetTicks();
+    m_attack.startTime = time.simTime;
     
     // Set attack position based on player direction
     switch (m_dir) {
@@ -244,3 +156,26 @@ void Player::handleSwordsmanAttack() {
     
     std::cout << "Swordsman slashed!" << std::endl;
 }
+
+bool Player::launchProjectile(ProjectileType type, const FrameTime& time) {
+    if (!m_projectiles) return false;
+    
+    float dirX = 0, dirY = 0;
+    
+    // Set direction based on player facing direction
+    switch (m_dir) {
+        case UP: dirY = -1; break;
+        case DOWN: dirY = 1; break;
+        case LEFT: dirX = -1; break;
+        case RIGHT: dirX = 1; break;
+    }
+    
+    // Normalize direction
+    float length = sqrt(dirX * dirX + dirY * dirY);
+    if (length > 0) {
+        dirX /= length;
+        dirY /= length;
+    }
+    
+    return m_projectiles->spawn(type, m_x + PLAYER_SIZE/2, m_y + PLAYER_SIZE/2, dirX, dirY, time.simTime) >= 0;
+}
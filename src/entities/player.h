@@ -1,9 +1,13 @@
 #pragma once
 #include <SDL.h>
 #include "entity.h"
-#include "projectile.h"
 #include <vector>
 
+// Forward declarations
+class ProjectileSystem;
+class SpriteBatch;
+enum class ProjectileType;
+
 enum Direction { UP, DOWN, LEFT, RIGHT };
 
 enum class CharacterClass {
@@ -28,26 +32,24 @@ public:
     void initialize(int startX, int startY);
     
     // Update player state
-    void update() override;
+    void update(const FrameTime& time);
     
     // Render player
-    void render(SDL_Renderer* renderer, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY) const override;
+    void render(SpriteBatch& batch, SDL_Texture* texture, int cameraOffsetX, int cameraOffsetY, const FrameTime& time) const;
     
     // Handle input
-    void handleInput(const Uint8* keystate);
-    void handleAttack();
+    // stepScale is the tick length relative to a 60 Hz tick
+    void handleInput(const Uint8* keystate, float stepScale = 1.0f);
+    void handleAttack(const FrameTime& time);
     
     // Character class management
     void setCharacterClass(CharacterClass characterClass);
     CharacterClass getCharacterClass() const { return m_characterClass; }
     
     // Projectile management
-    void updateProjectiles();
-    void renderProjectiles(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY) const;
-    std::vector<PlayerProjectile>& getProjectiles() { return m_projectiles; }
-    const std::vector<PlayerProjectile>& getProjectiles() const { return m_projectiles; }
+    // Ranged attacks launch into this store (owned by GameManager)
+    void setProjectileSystem(ProjectileSystem* projectiles) { m_projectiles = projectiles; }
     void clearProjectiles();
-    void removeExplodedProjectiles();
     
     // Player state management
     void handleDeath();
@@ -63,9 +65,6 @@ public:
     Direction getDirection() const { return m_dir; }
     const Attack& getAttack() const { return m_attack; }
     
-    // Entity interface
-    int getSize() const override { return PLAYER_SIZE; }
-    
     // Constants
     static const int PLAYER_SIZE = 16;
     static const int PLAYER_SPEED = 5;
@@ -77,11 +76,12 @@ private:
     bool m_alive;
     int m_score;
     CharacterClass m_characterClass;
-    std::vector<PlayerProjectile> m_projectiles;
+    ProjectileSystem* m_projectiles;
     
     // Attack methods for different classes
-    void handleBomberAttack();
-    void handleArcherAttack();
-    void handleMageAttack();
-    void handleSwordsmanAttack();
+    void handleBomberAttack(const FrameTime& time);
+    void handleArcherAttack(const FrameTime& time);
+    void handleMageAttack(const FrameTime& time);
+    void handleSwordsmanAttack(const FrameTime& time);
+    bool launchProjectile(ProjectileType type, const FrameTime& time);
 };
@@ -0,0 +1,234 @@
+// Headless simulation driver.
+// Runs GameManager::update with scripted input as fast as possible (no window,
+// renderer or assets) and reports throughput and per-phase timings.
+//
+// Usage: game_headless [--scenario FILE] [--ticks N] [--tick-rate HZ] [--threads N]
+//                      [--seed N] [--class swordsman|bomber|archer|mage] [--idle]
+//                      [--no-lod] [--report-every N]
+//
+// --scenario loads the enemy load, level curve, character class, input pattern
+// and run length from a scenario file; the other flags override it. Without
+// --ticks the run lasts the scenario's duration_seconds, or 10000 ticks.
+//
+// --report-every prints entity counts and item/total time per tick for each
+// window of N ticks, to check that costs stay flat over long runs.
+#define SDL_MAIN_HANDLED
+#include <SDL.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "systems/game_manager.h"
+#include "systems/frame_clock.h"
+#include "systems/job_system.h"
+#include "systems/scenario.h"
+
+namespace {
+
+struct HeadlessOptions {
+    std::string scenarioPath;
+    int ticks = 0; // 0 = from the scenario
+    int tickRate = FrameClock::BASE_TICK_RATE;
+    int threads = 0;
+    unsigned long long seed = 1;
+    bool hasCharacterClass = false;
+    CharacterClass characterClass = CharacterClass::SWORDSMAN;
+    bool idle = false;
+    bool lod = true;
+    int reportEvery = 0;
+};
+
+// World size matching the shipped tilemap (1000x1000 tiles of 16px)
+const int WORLD_WIDTH = 16000;
+const int WORLD_HEIGHT = 16000;
+
+// Run length when neither --ticks nor the scenario gives one
+const int DEFAULT_TICKS = 10000;
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--scenario FILE] [--ticks N] [--tick-rate HZ] [--threads N] [--seed N]"
+              << " [--class swordsman|bomber|archer|mage] [--idle] [--no-lod] [--report-every N]" << std::endl;
+}
+
+bool parseOptions(int argc, char* argv[], HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        
+        if (arg == "--scenario" && hasValue) {
+            options.scenarioPath = argv[++i];
+        } else if (arg == "--ticks" && hasValue) {
+            options.ticks = std::atoi(argv[++i]);
+        } else if (arg == "--tick-rate" && hasValue) {
+            options.tickRate = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--class" && hasValue) {
+            if (!Scenario::parseCharacterClass(argv[++i], options.characterClass)) {
+                std::cerr << "Unknown character class: " << argv[i] << std::endl;
+                return false;
+            }
+            options.hasCharacterClass = true;
+        } else if (arg == "--idle") {
+            options.idle = true;
+        } else if (arg == "--no-lod") {
+            options.lod = false;
+        } else if (arg == "--report-every" && hasValue) {
+            options.reportEvery = std::atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    
+    if (options.ticks < 0 || options.tickRate <= 0 || options.threads < 0 || options.reportEvery < 0) {
+        std::cerr << "--tick-rate must be positive, --ticks, --threads and --report-every non-negative" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Fill in whatever the command line left open from the scenario
+void applyScenario(const Scenario& scenario, HeadlessOptions& options) {
+    if (!options.hasCharacterClass) {
+        options.characterClass = scenario.getCharacterClass();
+    }
+    if (scenario.getInput() == ScriptedInput::IDLE) {
+        options.idle = true;
+    }
+    if (options.ticks == 0) {
+        options.ticks = scenario.getDuration() > 0 ? scenario.getDuration() * options.tickRate : DEFAULT_TICKS;
+    }
+}
+
+// Scripted input: walk a square, turning every turn interval, and attack regularly
+void applyScriptedInput(GameManager& gameManager, const HeadlessOptions& options, const Scenario& scenario,
+                        const FrameTime& time, Uint8* keystate) {
+    if (options.idle) return;
+    
+    // Cycle W, D, S, A
+    static const SDL_Scancode directions[] = {SDL_SCANCODE_W, SDL_SCANCODE_D, SDL_SCANCODE_S, SDL_SCANCODE_A};
+    int tick = static_cast<int>(time.tick) - 1; // 0-based
+    int leg = (tick / (options.tickRate * scenario.getTurnInterval())) % 4;
+    for (SDL_Scancode key : directions) {
+        keystate[key] = 0;
+    }
+    keystate[directions[leg]] = 1;
+    
+    if (scenario.getAttacksPerSecond() > 0) {
+        int attackInterval = std::max(1, options.tickRate / scenario.getAttacksPerSecond());
+        if (tick % attackInterval == 0) {
+            gameManager.getPlayer().handleAttack(time);
+        }
+    }
+    
+    gameManager.getPlayer().handleInput(keystate, time.stepScale);
+}
+
+// One line per report window: where the run is and what a tick cost in it
+void printWindowReport(const GameManager& gameManager, const FrameTime& time, int windowTicks,
+                       double& lastItemSeconds, double& lastTotalSeconds) {
+    double itemSeconds = gameManager.getPhaseTime(UpdatePhase::ITEMS);
+    double totalSeconds = 0.0;
+    for (int i = 0; i < static_cast<int>(UpdatePhase::COUNT); i++) {
+        totalSeconds += gameManager.getPhaseTime(static_cast<UpdatePhase>(i));
+    }
+    
+    std::printf("[%7.1f s] tick %8llu  enemies %6zu  items %4d  items %7.2f us/tick  total %8.2f us/tick\n",
+                time.simTime / 1000.0, static_cast<unsigned long long>(time.tick),
+                gameManager.getEnemies().size(), gameManager.getItems().size(),
+                (itemSeconds - lastItemSeconds) * 1e6 / windowTicks,
+                (totalSeconds - lastTotalSeconds) * 1e6 / windowTicks);
+    lastItemSeconds = itemSeconds;
+    lastTotalSeconds = totalSeconds;
+}
+    
+} // namespace
+
+int main(int argc, char* argv[]) {
+    HeadlessOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    Scenario scenario;
+    if (!options.scenarioPath.empty() && !scenario.loadFromFile(options.scenarioPath)) {
+        return 1;
+    }
+    applyScenario(scenario, options);
+    
+    // Only the timer is needed; no video subsystem is initialized
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+    
+    JobSystem* jobs = new JobSystem();
+    jobs->start(options.threads);
+    
+    GameManager* gameManager = new GameManager();
+    gameManager->setJobSystem(jobs);
+    gameManager->setScenario(scenario);
+    gameManager->setSeed(options.seed);
+    gameManager->initialize(WORLD_WIDTH, WORLD_HEIGHT);
+    gameManager->getPlayer().setCharacterClass(options.characterClass);
+    gameManager->setProfilingEnabled(true);
+    gameManager->getSimulationLod().setEnabled(options.lod);
+    
+    Uint8 keystate[SDL_NUM_SCANCODES];
+    std::memset(keystate, 0, sizeof(keystate));
+    
+    // Simulated time advances one tick per step regardless of wall time
+    FrameClock clock;
+    clock.setTickRate(options.tickRate);
+    
+    std::cout << "Running scenario '" << scenario.getName() << "' (" << Scenario::getCharacterClassName(options.characterClass)
+              << ", up to " << scenario.getMaxEnemies() << " enemies) for " << options.ticks << " ticks at "
+              << options.tickRate << " Hz" << std::endl;
+    
+    double lastItemSeconds = 0.0;
+    double lastTotalSeconds = 0.0;
+    
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int tick = 0; tick < options.ticks; tick++) {
+        const FrameTime& time = clock.advance();
+        
+        gameManager->savePreviousPositions();
+        applyScriptedInput(*gameManager, options, scenario, time, keystate);
+        gameManager->update(time);
+        
+        if (options.reportEvery > 0 && time.tick % options.reportEvery == 0) {
+            printWindowReport(*gameManager, time, options.reportEvery, lastItemSeconds, lastTotalSeconds);
+        }
+    }
+    double elapsed = static_cast<double>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    
+    // Report
+    std::printf("\nticks: %d  wall: %.3f s  ticks/sec: %.1f  (%.3f ms/tick)\n",
+                options.ticks, elapsed, options.ticks / elapsed, elapsed * 1000.0 / options.ticks);
+    std::printf("enemies: %zu  items: %d  score: %d  threads: %d\n",
+                gameManager->getEnemies().size(), gameManager->getItems().size(),
+                gameManager->getScore(), gameManager->getWorkerThreads());
+    
+    std::printf("\n%-12s %10s %10s %7s\n", "phase", "total ms", "us/tick", "share");
+    for (int i = 0; i < static_cast<int>(UpdatePhase::COUNT); i++) {
+        UpdatePhase phase = static_cast<UpdatePhase>(i);
+        double seconds = gameManager->getPhaseTime(phase);
+        std::printf("%-12s %10.2f %10.2f %6.1f%%\n", GameManager::getPhaseName(phase),
+                    seconds * 1000.0, seconds * 1e6 / options.ticks, elapsed > 0 ? seconds * 100.0 / elapsed : 0.0);
+    }
+    
+    std::printf("\n");
+    gameManager->logPoolUsage();
+    gameManager->getSimulationLod().logStats(options.ticks);
+    
+    delete gameManager;
+    jobs->shutdown();
+    delete jobs;
+    SDL_Quit();
+    return 0;
+}
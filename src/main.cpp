@@ -112,7 +112,10 @@ int SDL_main(int argc, char* argv[]) {
     // Standard desktop game loop
     while (!g_sceneManager->shouldQuit()) {
         gameLoop();
-        SDL_Delay(16);
+        
+        // Simulation runs on a fixed tick inside GameScene; just yield here
+        // (present is already paced by vsync when available)
+        SDL_Delay(1);
     }
     #endif
 
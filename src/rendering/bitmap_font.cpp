@@ -1,4 +1,6 @@
 #include "bitmap_font.h"
+#include "sprite_batch.h"
+#include <cstdio>
 #include <iostream>
 #if defined(__EMSCRIPTEN__) || defined(_WIN32)
 #include <SDL_image.h>
@@ -54,23 +56,53 @@ bool BitmapFont::loadFont(SDL_Renderer* renderer, const char* fontPath) {
 void BitmapFont::renderText(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color) {
     if (!fontTexture) return;
     
+    // Set color modulation once for the whole string
+    SDL_SetTextureColorMod(fontTexture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(fontTexture, color.a);
+    
     int currentX = x;
     for (char c : text) {
-        renderChar(renderer, c, currentX, y, color);
+        renderChar(renderer, c, currentX, y);
         currentX += charWidth;
     }
 }
 
+void BitmapFont::renderText(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color) {
+    if (!fontTexture) return;
+    
+    int currentX = x;
+    for (const char* c = text; *c; c++) {
+        SDL_Rect srcRect = getCharRect(*c);
+        batch.draw(fontTexture, &srcRect, {currentX, y, charWidth, charHeight}, color);
+        currentX += charWidth;
+    }
+}
+
+void BitmapFont::renderGlyphs(SpriteBatch& batch, const SDL_Rect* glyphs, int count, int x, int y, SDL_Color color) {
+    if (!fontTexture) return;
+    
+    for (int i = 0; i < count; i++) {
+        batch.draw(fontTexture, &glyphs[i], {x + i * charWidth, y, charWidth, charHeight}, color);
+    }
+}
+
 void BitmapFont::renderNumber(SDL_Renderer* renderer, int number, int x, int y, SDL_Color color) {
     if (!fontTexture) return;
     
-    std::string numStr = std::to_string(number);
+    char numStr[16];
+    std::snprintf(numStr, sizeof(numStr), "%d", number);
     renderText(renderer, numStr, x, y, color);
 }
 
-void BitmapFont::renderChar(SDL_Renderer* renderer, char c, int x, int y, SDL_Color color) {
+void BitmapFont::renderChar(SDL_Renderer* renderer, char c, int x, int y) {
     if (!fontTexture) return;
     
+    SDL_Rect srcRect = getCharRect(c);
+    SDL_Rect destRect = {x, y, charWidth, charHeight};
+    SDL_RenderCopy(renderer, fontTexture, &srcRect, &destRect);
+}
+
+SDL_Rect BitmapFont::getCharRect(char c) const {
     // dbyte font uses full ASCII range (0-255) in a 16x16 grid
     // Each character maps directly to its ASCII value
     int charIndex = static_cast<unsigned char>(c);
@@ -78,13 +110,5 @@ void BitmapFont::renderChar(SDL_Renderer* renderer, char c, int x, int y, SDL_Co
     // Calculate source rectangle for the character
     int srcX = (charIndex % charsPerRow) * charWidth;
     int srcY = (charIndex / charsPerRow) * charHeight;
-    
-    SDL_Rect srcRect = {srcX, srcY, charWidth, charHeight};
-    SDL_Rect destRect = {x, y, charWidth, charHeight};
-    
-    // Set color modulation
-    SDL_SetTextureColorMod(fontTexture, color.r, color.g, color.b);
-    SDL_SetTextureAlphaMod(fontTexture, color.a);
-    
-    SDL_RenderCopy(renderer, fontTexture, &srcRect, &destRect);
+    return {srcX, srcY, charWidth, charHeight};
 }
@@ -2,6 +2,8 @@
 #include <SDL.h>
 #include <string>
 
+class SpriteBatch;
+
 class BitmapFont {
 public:
     BitmapFont();
@@ -11,14 +13,24 @@ public:
     void renderText(SDL_Renderer* renderer, const std::string& text, int x, int y, SDL_Color color = {255, 255, 255, 255});
     void renderNumber(SDL_Renderer* renderer, int number, int x, int y, SDL_Color color = {255, 255, 255, 255});
     
+    // Queue the glyphs on a batch instead of drawing them one by one
+    void renderText(SpriteBatch& batch, const char* text, int x, int y, SDL_Color color = {255, 255, 255, 255});
+    
+    // Queue pre-looked-up glyphs (see TextLabel), one character cell apart
+    void renderGlyphs(SpriteBatch& batch, const SDL_Rect* glyphs, int count, int x, int y,
+                      SDL_Color color = {255, 255, 255, 255});
+    
     int getCharWidth() const { return charWidth; }
     int getCharHeight() const { return charHeight; }
     
+    // Source rect of a character in the font texture
+    SDL_Rect getCharRect(char c) const;
+    
 private:
     SDL_Texture* fontTexture;
     int charWidth;
     int charHeight;
     int charsPerRow;
     
-    void renderChar(SDL_Renderer* renderer, char c, int x, int y, SDL_Color color);
+    void renderChar(SDL_Renderer* renderer, char c, int x, int y);
 };
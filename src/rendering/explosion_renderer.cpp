@@ -0,0 +1,111 @@
+#include "explosion_renderer.h"
+#include "sprite_batch.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+ExplosionRenderer::ExplosionRenderer() : m_renderer(nullptr), m_texturesFailed(false) {
+    for (int i = 0; i < TEXTURE_COUNT; i++) {
+        m_textures[i] = nullptr;
+    }
+    
+    for (int j = 0; j <= OUTLINE_SEGMENTS; j++) {
+        double angle = (2.0 * M_PI * (j % OUTLINE_SEGMENTS)) / OUTLINE_SEGMENTS;
+        m_unitCircleX[j] = static_cast<float>(std::cos(angle));
+        m_unitCircleY[j] = static_cast<float>(std::sin(angle));
+    }
+}
+
+ExplosionRenderer::~ExplosionRenderer() {
+    releaseTextures();
+}
+
+void ExplosionRenderer::renderFill(SpriteBatch& batch, SDL_Renderer* renderer, int centerX, int centerY, float radius) {
+    int size = static_cast<int>(radius * 2.0f + 0.5f);
+    if (size < 2 || !renderer) return;
+    
+    if (renderer != m_renderer && !m_texturesFailed) {
+        releaseTextures();
+        m_texturesFailed = !createTextures(renderer);
+    }
+    if (m_texturesFailed) return;
+    
+    // Smallest texture covering the radius (the largest one is stretched beyond it)
+    int level = 0;
+    while (level < TEXTURE_COUNT - 1 && (BASE_TEXTURE_RADIUS << level) < radius) {
+        level++;
+    }
+    
+    batch.draw(m_textures[level], nullptr, {centerX - size / 2, centerY - size / 2, size, size});
+}
+
+void ExplosionRenderer::renderOutline(SDL_Renderer* renderer, int centerX, int centerY, float radius) const {
+    SDL_Point points[OUTLINE_SEGMENTS + 1];
+    for (int j = 0; j <= OUTLINE_SEGMENTS; j++) {
+        points[j].x = centerX + static_cast<int>(radius * m_unitCircleX[j]);
+        points[j].y = centerY + static_cast<int>(radius * m_unitCircleY[j]);
+    }
+    
+    SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow outline
+    SDL_RenderDrawLines(renderer, points, OUTLINE_SEGMENTS + 1);
+}
+
+void ExplosionRenderer::releaseTextures() {
+    for (int i = 0; i < TEXTURE_COUNT; i++) {
+        if (m_textures[i]) {
+            SDL_DestroyTexture(m_textures[i]);
+            m_textures[i] = nullptr;
+        }
+    }
+    m_renderer = nullptr;
+    m_texturesFailed = false;
+}
+
+bool ExplosionRenderer::createTextures(SDL_Renderer* renderer) {
+    for (int i = 0; i < TEXTURE_COUNT; i++) {
+        m_textures[i] = createGradientTexture(renderer, BASE_TEXTURE_RADIUS << i);
+        if (!m_textures[i]) {
+            std::cerr << "Failed to create explosion texture: " << SDL_GetError() << std::endl;
+            releaseTextures();
+            return false;
+        }
+    }
+    m_renderer = renderer;
+    return true;
+}
+
+SDL_Texture* ExplosionRenderer::createGradientTexture(SDL_Renderer* renderer, int radius) {
+    int size = radius * 2;
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) return nullptr;
+    
+    // Yellow-orange core fading to translucent orange at the rim, with a one
+    // pixel soft edge so downscaled copies stay round
+    Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+    int pitch = surface->pitch / 4;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            float dx = x + 0.5f - radius;
+            float dy = y + 0.5f - radius;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            float t = std::min(1.0f, distance / radius);
+            float coverage = std::max(0.0f, std::min(1.0f, radius - distance + 0.5f));
+            
+            Uint8 green = static_cast<Uint8>(180.0f - 80.0f * t);
+            Uint8 blue = static_cast<Uint8>(60.0f - 60.0f * t);
+            Uint8 alpha = static_cast<Uint8>((170.0f - 50.0f * t) * coverage);
+            pixels[y * pitch + x] = SDL_MapRGBA(surface->format, 255, green, blue, alpha);
+        }
+    }
+    
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+    return texture;
+}
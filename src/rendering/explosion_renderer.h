@@ -0,0 +1,42 @@
+#pragma once
+#include <SDL.h>
+
+class SpriteBatch;
+
+// Draws explosion effects as a scaled radial-gradient sprite with an outline.
+// The gradient is rendered once into a few textures of doubling size; each
+// explosion copies the smallest one that covers its current radius, so the
+// sprite is only ever scaled down. The outline follows a unit-circle table
+// instead of calling cos/sin per segment. Textures are made from surfaces,
+// so they survive SDL_RENDER_TARGETS_RESET and only need rebuilding after a
+// device reset.
+class ExplosionRenderer {
+public:
+    ExplosionRenderer();
+    ~ExplosionRenderer();
+    
+    // Queue the gradient disc on the batch (nothing if the textures couldn't be made)
+    void renderFill(SpriteBatch& batch, SDL_Renderer* renderer, int centerX, int centerY, float radius);
+    
+    // Draw the outline directly with the renderer (flush the batch first)
+    void renderOutline(SDL_Renderer* renderer, int centerX, int centerY, float radius) const;
+    
+    // The renderer was recreated (SDL_RENDER_DEVICE_RESET) or is going away;
+    // textures are made again on the next renderFill
+    void releaseTextures();
+    
+    static constexpr int TEXTURE_COUNT = 4;
+    static constexpr int BASE_TEXTURE_RADIUS = 16; // Radii 16, 32, 64, 128
+    static constexpr int OUTLINE_SEGMENTS = 32;
+
+private:
+    SDL_Renderer* m_renderer; // Renderer the textures belong to
+    SDL_Texture* m_textures[TEXTURE_COUNT];
+    bool m_texturesFailed;    // Creation failed; don't retry every frame
+    
+    float m_unitCircleX[OUTLINE_SEGMENTS + 1]; // Closed loop: the last point repeats the first
+    float m_unitCircleY[OUTLINE_SEGMENTS + 1];
+    
+    bool createTextures(SDL_Renderer* renderer);
+    static SDL_Texture* createGradientTexture(SDL_Renderer* renderer, int radius);
+};
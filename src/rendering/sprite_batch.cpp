@@ -0,0 +1,122 @@
+#include "sprite_batch.h"
+
+SpriteBatch::SpriteBatch()
+    : m_renderer(nullptr), m_texture(nullptr), m_textureWidth(1), m_textureHeight(1)
+    , m_drawCalls(0), m_quadCount(0) {
+    m_vertices.reserve(4096);
+    m_indices.reserve(6144);
+}
+
+SpriteBatch::~SpriteBatch() {
+}
+
+void SpriteBatch::begin(SDL_Renderer* renderer) {
+    m_renderer = renderer;
+    m_texture = nullptr;
+    m_vertices.clear();
+    m_indices.clear();
+    m_drawCalls = 0;
+    m_quadCount = 0;
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& dstRect, SDL_Color color) {
+    if (!texture) return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    setTexture(texture);
+    if (srcRect) {
+        addQuad(dstRect,
+                static_cast<float>(srcRect->x) / m_textureWidth, static_cast<float>(srcRect->y) / m_textureHeight,
+                static_cast<float>(srcRect->x + srcRect->w) / m_textureWidth,
+                static_cast<float>(srcRect->y + srcRect->h) / m_textureHeight, color);
+    } else {
+        addQuad(dstRect, 0.0f, 0.0f, 1.0f, 1.0f, color);
+    }
+#else
+    SDL_SetTextureColorMod(texture, color.r, color.g, color.b);
+    SDL_SetTextureAlphaMod(texture, color.a);
+    SDL_RenderCopy(m_renderer, texture, srcRect, &dstRect);
+    m_drawCalls++;
+    m_quadCount++;
+#endif
+}
+
+void SpriteBatch::fillRect(const SDL_Rect& rect, SDL_Color color) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    setTexture(nullptr);
+    addQuad(rect, 0.0f, 0.0f, 0.0f, 0.0f, color);
+#else
+    SDL_SetRenderDrawColor(m_renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(m_renderer, &rect);
+    m_drawCalls++;
+    m_quadCount++;
+#endif
+}
+
+void SpriteBatch::drawRect(const SDL_Rect& rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0) return;
+    
+    // Top and bottom rows, then the sides between them
+    fillRect({rect.x, rect.y, rect.w, 1}, color);
+    if (rect.h > 1) {
+        fillRect({rect.x, rect.y + rect.h - 1, rect.w, 1}, color);
+    }
+    if (rect.h > 2) {
+        fillRect({rect.x, rect.y + 1, 1, rect.h - 2}, color);
+        if (rect.w > 1) {
+            fillRect({rect.x + rect.w - 1, rect.y + 1, 1, rect.h - 2}, color);
+        }
+    }
+}
+
+void SpriteBatch::flush() {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (m_indices.empty()) return;
+    
+    SDL_RenderGeometry(m_renderer, m_texture, m_vertices.data(), static_cast<int>(m_vertices.size()),
+                       m_indices.data(), static_cast<int>(m_indices.size()));
+    m_drawCalls++;
+    m_vertices.clear();
+    m_indices.clear();
+#endif
+}
+
+void SpriteBatch::setTexture(SDL_Texture* texture) {
+    if (texture == m_texture) return;
+    
+    // A new texture ends the current run
+    flush();
+    m_texture = texture;
+    m_textureWidth = 1;
+    m_textureHeight = 1;
+    if (texture) {
+        // Vertex colours do the modulation; clear any mod left by direct draws
+        SDL_SetTextureColorMod(texture, 255, 255, 255);
+        SDL_SetTextureAlphaMod(texture, 255);
+        SDL_QueryTexture(texture, nullptr, nullptr, &m_textureWidth, &m_textureHeight);
+        if (m_textureWidth <= 0) m_textureWidth = 1;
+        if (m_textureHeight <= 0) m_textureHeight = 1;
+    }
+}
+
+void SpriteBatch::addQuad(const SDL_Rect& dstRect, float u0, float v0, float u1, float v1, SDL_Color color) {
+    float x0 = static_cast<float>(dstRect.x);
+    float y0 = static_cast<float>(dstRect.y);
+    float x1 = static_cast<float>(dstRect.x + dstRect.w);
+    float y1 = static_cast<float>(dstRect.y + dstRect.h);
+    
+    int base = static_cast<int>(m_vertices.size());
+    m_vertices.push_back({{x0, y0}, color, {u0, v0}});
+    m_vertices.push_back({{x1, y0}, color, {u1, v0}});
+    m_vertices.push_back({{x1, y1}, color, {u1, v1}});
+    m_vertices.push_back({{x0, y1}, color, {u0, v1}});
+    
+    // Two triangles: top-right and bottom-left halves
+    m_indices.push_back(base);
+    m_indices.push_back(base + 1);
+    m_indices.push_back(base + 2);
+    m_indices.push_back(base);
+    m_indices.push_back(base + 2);
+    m_indices.push_back(base + 3);
+    m_quadCount++;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// Collects textured and solid-colour quads and draws each run of quads that
+// share a texture with a single SDL_RenderGeometry call.
+// Quads are drawn in the order they were queued - switching texture just
+// starts a new run - so the picture is the same as issuing the equivalent
+// SDL_RenderCopy / SDL_RenderFillRect calls one by one. Solid quads are a
+// texture of their own (nullptr), so neighbouring fills merge as well.
+// Flush before drawing anything directly with the renderer.
+// Without SDL_RenderGeometry (SDL older than 2.0.18) quads are drawn one by
+// one with the plain calls.
+class SpriteBatch {
+public:
+    SpriteBatch();
+    ~SpriteBatch();
+    
+    // Start a frame's batching on this renderer (resets the counters)
+    void begin(SDL_Renderer* renderer);
+    
+    // SDL_RenderCopy equivalent; srcRect nullptr = whole texture. color
+    // modulates the texture like SDL_SetTextureColorMod / AlphaMod would.
+    void draw(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& dstRect,
+              SDL_Color color = {255, 255, 255, 255});
+    
+    // SDL_RenderFillRect equivalent (blended with the renderer's draw blend mode)
+    void fillRect(const SDL_Rect& rect, SDL_Color color);
+    
+    // SDL_RenderDrawRect equivalent: a one pixel outline
+    void drawRect(const SDL_Rect& rect, SDL_Color color);
+    
+    // Draw everything queued so far
+    void flush();
+    
+    // Counters since begin()
+    int getDrawCalls() const { return m_drawCalls; }
+    int getQuadCount() const { return m_quadCount; }
+
+private:
+    SDL_Renderer* m_renderer;
+    SDL_Texture* m_texture;   // Texture of the queued run (nullptr = solid colour)
+    int m_textureWidth;       // Size of m_texture, for normalizing source rects
+    int m_textureHeight;
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+    
+    int m_drawCalls;
+    int m_quadCount;
+    
+    void setTexture(SDL_Texture* texture);
+    void addQuad(const SDL_Rect& dstRect, float u0, float v0, float u1, float v1, SDL_Color color);
+};
@@ -0,0 +1,52 @@
+#include "text_label.h"
+#include "bitmap_font.h"
+#include <cstdio>
+#include <cstring>
+
+TextLabel::TextLabel()
+    : m_length(0), m_prefixLength(0), m_number(0), m_hasNumber(false),
+      m_composedFont(nullptr), m_composeCount(0) {
+    m_text[0] = '\0';
+    m_glyphs.reserve(MAX_LENGTH);
+}
+
+void TextLabel::setText(const char* text) {
+    m_prefixLength = 0;
+    m_hasNumber = false;
+    if (std::strncmp(m_text, text, MAX_LENGTH) == 0) return;
+    
+    std::snprintf(m_text, sizeof(m_text), "%s", text);
+    m_length = static_cast<int>(std::strlen(m_text));
+    m_composedFont = nullptr;
+}
+
+void TextLabel::setPrefix(const char* prefix) {
+    setText(prefix);
+    m_prefixLength = m_length;
+}
+
+void TextLabel::setNumber(long long value) {
+    if (m_hasNumber && value == m_number) return;
+    
+    std::snprintf(m_text + m_prefixLength, sizeof(m_text) - m_prefixLength, "%lld", value);
+    m_length = static_cast<int>(std::strlen(m_text));
+    m_number = value;
+    m_hasNumber = true;
+    m_composedFont = nullptr;
+}
+
+void TextLabel::render(SpriteBatch& batch, BitmapFont& font, int x, int y, SDL_Color color) {
+    if (m_composedFont != &font) {
+        compose(font);
+    }
+    font.renderGlyphs(batch, m_glyphs.data(), static_cast<int>(m_glyphs.size()), x, y, color);
+}
+
+void TextLabel::compose(const BitmapFont& font) {
+    m_glyphs.clear();
+    for (int i = 0; i < m_length; i++) {
+        m_glyphs.push_back(font.getCharRect(m_text[i]));
+    }
+    m_composedFont = &font;
+    m_composeCount++;
+}
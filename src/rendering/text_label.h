@@ -0,0 +1,50 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+class BitmapFont;
+class SpriteBatch;
+
+// A line of bitmap-font text kept as ready-made glyph quads.
+// The quads are composed the first time the label is drawn after its text
+// changes, so text that stays the same costs no formatting, string
+// allocations or glyph lookups per frame - just its quads on the batch.
+// Colour is given per draw (it is a vertex attribute of the batch), so it
+// doesn't invalidate anything.
+class TextLabel {
+public:
+    static constexpr int MAX_LENGTH = 63;
+    
+    TextLabel();
+    
+    // Replace the text (cut at MAX_LENGTH); nothing happens if it is unchanged
+    void setText(const char* text);
+    
+    // Text shown in front of setNumber's value, e.g. "Shards: "
+    void setPrefix(const char* prefix);
+    
+    // Show prefix + value; the text is only reformatted when value changes
+    void setNumber(long long value);
+    
+    const char* getText() const { return m_text; }
+    int getLength() const { return m_length; }
+    
+    // Queue the glyphs with their top left at (x, y)
+    void render(SpriteBatch& batch, BitmapFont& font, int x, int y, SDL_Color color = {255, 255, 255, 255});
+    
+    // Times the glyph quads were rebuilt
+    int getComposeCount() const { return m_composeCount; }
+
+private:
+    char m_text[MAX_LENGTH + 1];
+    int m_length;
+    int m_prefixLength;               // Leading characters of m_text owned by setPrefix
+    long long m_number;
+    bool m_hasNumber;                 // m_text currently ends in m_number
+    
+    std::vector<SDL_Rect> m_glyphs;   // Source rect in the font texture per character
+    const BitmapFont* m_composedFont; // Font m_glyphs was built for (nullptr = stale)
+    int m_composeCount;
+    
+    void compose(const BitmapFont& font);
+};
@@ -0,0 +1,263 @@
+#include "tilemap_renderer.h"
+#include <algorithm>
+#include <iostream>
+
+TilemapRenderer::TilemapRenderer()
+    : m_renderer(nullptr), m_chunkTiles(DEFAULT_CHUNK_TILES)
+    , m_chunkPixelWidth(0), m_chunkPixelHeight(0)
+    , m_chunksX(0), m_chunksY(0), m_maxResident(0)
+    , m_targetsSupported(false), m_frame(0)
+    , m_chunksBuilt(0), m_chunksEvicted(0), m_lastDrawCalls(0) {
+}
+
+TilemapRenderer::~TilemapRenderer() {
+    releaseTextures();
+}
+
+void TilemapRenderer::initialize(SDL_Renderer* renderer, const TilemapData& tilemap, int chunkTiles, int memoryBudget) {
+    releaseTextures();
+    m_renderer = renderer;
+    m_chunkTiles = std::max(1, chunkTiles);
+    m_chunkPixelWidth = m_chunkTiles * tilemap.tileWidth;
+    m_chunkPixelHeight = m_chunkTiles * tilemap.tileHeight;
+    m_chunksX = (tilemap.width + m_chunkTiles - 1) / m_chunkTiles;
+    m_chunksY = (tilemap.height + m_chunkTiles - 1) / m_chunkTiles;
+    m_chunks.assign(m_chunksX * m_chunksY, Chunk());
+    m_resident.clear();
+    m_frame = 0;
+    
+    // RGBA textures, so budget / 4 bytes per pixel
+    int chunkBytes = std::max(1, m_chunkPixelWidth * m_chunkPixelHeight * 4);
+    m_maxResident = std::max(1, memoryBudget / chunkBytes);
+    m_targetsSupported = renderer && SDL_RenderTargetSupported(renderer);
+    
+    if (m_targetsSupported) {
+        std::cout << "Tilemap chunks: " << m_chunksX << "x" << m_chunksY << " of " << m_chunkTiles << "x" << m_chunkTiles
+                  << " tiles, up to " << m_maxResident << " cached (" << chunkBytes / 1024 << " KB each)" << std::endl;
+    } else {
+        std::cout << "Render targets not supported - drawing the tilemap tile by tile" << std::endl;
+    }
+}
+
+void TilemapRenderer::render(const TilemapData& tilemap, int offsetX, int offsetY, int viewportX, int viewportY,
+                             int viewportW, int viewportH) {
+    m_lastDrawCalls = 0;
+    if (!tilemap.tilesetTexture || !tilemap.tilesPrepared || m_chunks.empty()) {
+        return;
+    }
+    m_frame++;
+    
+    // Visible chunk range, in the same terms as TMXLoader's visible tile range
+    int left = viewportX - offsetX;
+    int top = viewportY - offsetY;
+    int startX = std::max(0, left / m_chunkPixelWidth);
+    int endX = std::min(m_chunksX, (left + viewportW + m_chunkPixelWidth - 1) / m_chunkPixelWidth);
+    int startY = std::max(0, top / m_chunkPixelHeight);
+    int endY = std::min(m_chunksY, (top + viewportH + m_chunkPixelHeight - 1) / m_chunkPixelHeight);
+    
+    // Mark every visible chunk first so building one can't evict another
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            m_chunks[y * m_chunksX + x].lastUsedFrame = m_frame;
+        }
+    }
+    
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            int chunkIndex = y * m_chunksX + x;
+            const Chunk& chunk = m_chunks[chunkIndex];
+            
+            int tileStartX = x * m_chunkTiles;
+            int tileStartY = y * m_chunkTiles;
+            int tileEndX = std::min(tilemap.width, tileStartX + m_chunkTiles);
+            int tileEndY = std::min(tilemap.height, tileStartY + m_chunkTiles);
+            
+            if (!chunk.built && !buildChunk(tilemap, chunkIndex)) {
+                // Only the chunk's visible tiles
+                int visibleStartX = std::max(tileStartX, left / tilemap.tileWidth);
+                int visibleEndX = std::min(tileEndX, (left + viewportW + tilemap.tileWidth - 1) / tilemap.tileWidth);
+                int visibleStartY = std::max(tileStartY, top / tilemap.tileHeight);
+                int visibleEndY = std::min(tileEndY, (top + viewportH + tilemap.tileHeight - 1) / tilemap.tileHeight);
+                m_lastDrawCalls += drawTiles(tilemap, visibleStartX, visibleStartY, visibleEndX, visibleEndY, offsetX, offsetY);
+                continue;
+            }
+            if (chunk.empty) {
+                continue;
+            }
+            
+            // Edge chunks only use part of their texture
+            SDL_Rect srcRect = {0, 0, (tileEndX - tileStartX) * tilemap.tileWidth, (tileEndY - tileStartY) * tilemap.tileHeight};
+            SDL_Rect dstRect = {x * m_chunkPixelWidth + offsetX, y * m_chunkPixelHeight + offsetY, srcRect.w, srcRect.h};
+            SDL_RenderCopy(m_renderer, chunk.texture, &srcRect, &dstRect);
+            m_lastDrawCalls++;
+        }
+    }
+    
+    // Build a chunk or so ahead of the camera so crossing into it doesn't
+    // stall. The whole ring counts as in use, so prefetching only takes
+    // textures from chunks further away and can't thrash a small budget.
+    int prefetchStartX = std::max(0, startX - PREFETCH_CHUNKS);
+    int prefetchEndX = std::min(m_chunksX, endX + PREFETCH_CHUNKS);
+    int prefetchStartY = std::max(0, startY - PREFETCH_CHUNKS);
+    int prefetchEndY = std::min(m_chunksY, endY + PREFETCH_CHUNKS);
+    for (int y = prefetchStartY; y < prefetchEndY; y++) {
+        for (int x = prefetchStartX; x < prefetchEndX; x++) {
+            m_chunks[y * m_chunksX + x].lastUsedFrame = m_frame;
+        }
+    }
+    
+    int prefetched = 0;
+    for (int y = prefetchStartY; y < prefetchEndY && prefetched < MAX_PREFETCH_PER_FRAME; y++) {
+        for (int x = prefetchStartX; x < prefetchEndX && prefetched < MAX_PREFETCH_PER_FRAME; x++) {
+            if (m_chunks[y * m_chunksX + x].built) continue;
+            
+            // Stop once nothing can be built without evicting the ring
+            if (!buildChunk(tilemap, y * m_chunksX + x)) return;
+            prefetched++;
+        }
+    }
+}
+
+void TilemapRenderer::invalidate() {
+    for (Chunk& chunk : m_chunks) {
+        chunk.built = false;
+    }
+}
+
+void TilemapRenderer::releaseTextures() {
+    for (int chunkIndex : m_resident) {
+        SDL_DestroyTexture(m_chunks[chunkIndex].texture);
+        m_chunks[chunkIndex].texture = nullptr;
+    }
+    m_resident.clear();
+    invalidate();
+}
+
+bool TilemapRenderer::buildChunk(const TilemapData& tilemap, int chunkIndex) {
+    Chunk& chunk = m_chunks[chunkIndex];
+    int chunkX = chunkIndex % m_chunksX;
+    int chunkY = chunkIndex / m_chunksX;
+    
+    if (isChunkEmpty(tilemap, chunkX, chunkY)) {
+        chunk.empty = true;
+        chunk.built = true;
+        return true;
+    }
+    if (!m_targetsSupported) {
+        return false;
+    }
+    
+    if (!chunk.texture) {
+        chunk.texture = acquireTexture();
+        if (!chunk.texture) {
+            return false;
+        }
+        m_resident.push_back(chunkIndex);
+    }
+    
+    // Render the chunk's tiles into its texture, then restore the previous target
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(m_renderer);
+    if (SDL_SetRenderTarget(m_renderer, chunk.texture) != 0) {
+        std::cerr << "Failed to render tilemap chunk, falling back to per-tile drawing: " << SDL_GetError() << std::endl;
+        m_targetsSupported = false;
+        return false;
+    }
+    SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+    SDL_RenderClear(m_renderer);
+    
+    int tileStartX = chunkX * m_chunkTiles;
+    int tileStartY = chunkY * m_chunkTiles;
+    drawTiles(tilemap, tileStartX, tileStartY, std::min(tilemap.width, tileStartX + m_chunkTiles),
+              std::min(tilemap.height, tileStartY + m_chunkTiles),
+              -tileStartX * tilemap.tileWidth, -tileStartY * tilemap.tileHeight);
+    SDL_SetRenderTarget(m_renderer, previousTarget);
+    
+    chunk.empty = false;
+    chunk.built = true;
+    m_chunksBuilt++;
+    return true;
+}
+
+SDL_Texture* TilemapRenderer::acquireTexture() {
+    // Under budget: make a new one
+    if (static_cast<int>(m_resident.size()) < m_maxResident) {
+        SDL_Texture* texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                 m_chunkPixelWidth, m_chunkPixelHeight);
+        if (!texture) {
+            std::cerr << "Failed to create tilemap chunk texture: " << SDL_GetError() << std::endl;
+            return nullptr;
+        }
+        // Empty tiles stay transparent
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        return texture;
+    }
+    
+    // Otherwise take the texture of the least recently drawn chunk, unless
+    // every resident chunk is on screen this frame
+    int victimSlot = -1;
+    for (int slot = 0; slot < static_cast<int>(m_resident.size()); slot++) {
+        const Chunk& candidate = m_chunks[m_resident[slot]];
+        if (candidate.lastUsedFrame >= m_frame) continue;
+        if (victimSlot < 0 || candidate.lastUsedFrame < m_chunks[m_resident[victimSlot]].lastUsedFrame) {
+            victimSlot = slot;
+        }
+    }
+    if (victimSlot < 0) {
+        return nullptr;
+    }
+    
+    Chunk& victim = m_chunks[m_resident[victimSlot]];
+    SDL_Texture* texture = victim.texture;
+    victim.texture = nullptr;
+    victim.built = false;
+    m_resident[victimSlot] = m_resident.back();
+    m_resident.pop_back();
+    m_chunksEvicted++;
+    return texture;
+}
+
+bool TilemapRenderer::isChunkEmpty(const TilemapData& tilemap, int chunkX, int chunkY) const {
+    int tileStartX = chunkX * m_chunkTiles;
+    int tileStartY = chunkY * m_chunkTiles;
+    int tileEndX = std::min(tilemap.width, tileStartX + m_chunkTiles);
+    int tileEndY = std::min(tilemap.height, tileStartY + m_chunkTiles);
+    
+    for (int y = tileStartY; y < tileEndY; y++) {
+        for (int x = tileStartX; x < tileEndX; x++) {
+            size_t tileIndex = static_cast<size_t>(y) * tilemap.width + x;
+            if (tileIndex < tilemap.tileData.size() && tilemap.tileData[tileIndex] != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int TilemapRenderer::drawTiles(const TilemapData& tilemap, int startX, int startY, int endX, int endY,
+                               int offsetX, int offsetY) {
+    int drawCalls = 0;
+    for (int y = startY; y < endY; y++) {
+        for (int x = startX; x < endX; x++) {
+            size_t tileIndex = static_cast<size_t>(y) * tilemap.width + x;
+            if (tileIndex >= tilemap.tileData.size()) {
+                continue;
+            }
+            
+            // 1-based tile IDs, 0 = empty
+            int tileId = tilemap.tileData[tileIndex] - 1;
+            if (tileId < 0 || tileId >= static_cast<int>(tilemap.tileRects.size())) {
+                continue;
+            }
+            
+            SDL_Rect dstRect = {
+                x * tilemap.tileWidth + offsetX,
+                y * tilemap.tileHeight + offsetY,
+                tilemap.tileWidth,
+                tilemap.tileHeight
+            };
+            SDL_RenderCopy(m_renderer, tilemap.tilesetTexture, &tilemap.tileRects[tileId], &dstRect);
+            drawCalls++;
+        }
+    }
+    return drawCalls;
+}
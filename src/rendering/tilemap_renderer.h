@@ -0,0 +1,81 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "../utils/tmx_loader.h"
+
+// Draws a tilemap from pre-baked chunk textures instead of one copy per tile.
+// The map is cut into square chunks of chunkTiles x chunkTiles tiles; each is
+// rendered once into a render-target texture the first time it is visible (or
+// a frame or two earlier, as the camera approaches) and then drawn with a
+// single copy. Textures are limited by a memory budget and the least recently
+// drawn chunk gives up its texture when a new one is needed. Empty chunks
+// take no texture. If render targets aren't available, or the budget can't
+// hold every visible chunk, the affected chunks are drawn tile by tile.
+class TilemapRenderer {
+public:
+    TilemapRenderer();
+    ~TilemapRenderer();
+    
+    // Set up the chunk grid for a loaded tilemap (tiles must be prepared)
+    void initialize(SDL_Renderer* renderer, const TilemapData& tilemap, int chunkTiles = DEFAULT_CHUNK_TILES,
+                    int memoryBudget = DEFAULT_MEMORY_BUDGET);
+    
+    // Draw the part of the tilemap inside the viewport (same arguments as
+    // TMXLoader::renderTilemap)
+    void render(const TilemapData& tilemap, int offsetX, int offsetY, int viewportX, int viewportY,
+                int viewportW, int viewportH);
+    
+    // Render target contents were lost (SDL_RENDER_TARGETS_RESET); chunks are
+    // rebuilt as they are next drawn
+    void invalidate();
+    
+    // The renderer was recreated (SDL_RENDER_DEVICE_RESET) or is going away;
+    // destroys every chunk texture
+    void releaseTextures();
+    
+    // Counters
+    int getResidentChunks() const { return static_cast<int>(m_resident.size()); }
+    int getMaxResidentChunks() const { return m_maxResident; }
+    int getChunksBuilt() const { return m_chunksBuilt; }
+    int getChunksEvicted() const { return m_chunksEvicted; }
+    int getLastDrawCalls() const { return m_lastDrawCalls; }
+    
+    static constexpr int DEFAULT_CHUNK_TILES = 32;
+    static constexpr int DEFAULT_MEMORY_BUDGET = 32 * 1024 * 1024; // bytes of chunk textures
+    static constexpr int PREFETCH_CHUNKS = 1;                      // Ring of chunks built ahead of the camera
+    static constexpr int MAX_PREFETCH_PER_FRAME = 1;               // Spread prefetch cost over frames
+
+private:
+    struct Chunk {
+        SDL_Texture* texture = nullptr;
+        Uint64 lastUsedFrame = 0;
+        bool built = false; // Texture holds this chunk's tiles
+        bool empty = false; // No tiles at all; nothing to draw
+    };
+    
+    SDL_Renderer* m_renderer;
+    std::vector<Chunk> m_chunks;
+    std::vector<int> m_resident;      // Chunks holding a texture
+    std::vector<SDL_Texture*> m_spare; // Textures of released chunks, ready for reuse
+    int m_chunkTiles;
+    int m_chunkPixelWidth;
+    int m_chunkPixelHeight;
+    int m_chunksX;
+    int m_chunksY;
+    int m_maxResident;
+    bool m_targetsSupported;
+    Uint64 m_frame;
+    
+    // Counters
+    int m_chunksBuilt;
+    int m_chunksEvicted;
+    int m_lastDrawCalls;
+    
+    // Make a chunk drawable; false if it must be drawn tile by tile this frame
+    bool buildChunk(const TilemapData& tilemap, int chunkIndex);
+    SDL_Texture* acquireTexture();
+    bool isChunkEmpty(const TilemapData& tilemap, int chunkX, int chunkY) const;
+    
+    // Copy the tiles of [startX, endX) x [startY, endY) with the given pixel offset
+    int drawTiles(const TilemapData& tilemap, int startX, int startY, int endX, int endY, int offsetX, int offsetY);
+};
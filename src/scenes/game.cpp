@@ -8,6 +8,7 @@
 #include "../systems/asset_manager.h"
 #include <iostream>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <vector>
@@ -26,50 +27,26 @@
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 600;
 
-// Spatial partitioning constants
-const int GRID_CELL_SIZE = 500; // Size of each grid cell (world size / grid size)
-const int MAX_GRID_WIDTH = 32; // Maximum grid width (world width / cell size)
-const int MAX_GRID_HEIGHT = 32; // Maximum grid height (world height / cell size)
-
 
 // Enemy class is now defined in enemy.h
 
 
-
-// Spatial partitioning grid
-struct GridCell {
-    std::vector<int> enemyIndices; // Indices of enemies in this cell
-};
-
 // Game state variables
 static AssetManager* g_assetManager = nullptr;
 static GameManager* g_gameManager = nullptr;
 
-// Spatial partitioning grid
-static GridCell g_spatialGrid[MAX_GRID_WIDTH * MAX_GRID_HEIGHT];
-static int g_gridWidth = 0;
-static int g_gridHeight = 0;
-
 // World bounds for enemy spawning and cleanup
 static int g_worldWidth = 0;
 static int g_worldHeight = 0;
 
 
-// Spatial partitioning functions removed - now handled by GameManager
-
-
-// Helper functions
-void renderText(SDL_Renderer* renderer, BitmapFont* font, const std::string& text, int x, int y, SDL_Color color) {
-    if (!font) {
-        return;
-    }
-    font->renderText(renderer, text, x, y, color);
-}
+// Spatial partitioning is handled by GameManager (see systems/spatial_grid.h)
 
 
 GameScene::GameScene() {
-    // Initialize random seed
-    srand(time(NULL));
+    m_scoreLabel.setPrefix("Shards: ");
+    m_enemyCountLabel.setPrefix("Enemies: ");
+    m_pausedLabel.setText("PAUSED");
 }
 
 GameScene::~GameScene() {
@@ -84,7 +61,7 @@ GameScene::~GameScene() {
     }
 }
 
-bool GameScene::initialize(SDL_Renderer* renderer) {
+bool GameScene::initialize(SDL_Renderer* renderer, const Settings& settings, const Scenario& scenario, JobSystem* jobs) {
     m_renderer = renderer;
     
     // Set up scaling for fullscreen
@@ -104,6 +81,17 @@ bool GameScene::initialize(SDL_Renderer* renderer) {
 
     // Initialize game manager
     g_gameManager = new GameManager();
+    g_gameManager->setJobSystem(jobs);
+    g_gameManager->setScenario(scenario);
+    m_clock.setTickRate(settings.getTickRate());
+    std::cout << "Simulation tick rate: " << m_clock.getTickRate() << " Hz" << std::endl;
+    
+    // A fixed seed from settings reproduces a run exactly; otherwise pick a new one
+    unsigned int seed = settings.getSeed();
+    if (seed == 0) {
+        seed = static_cast<unsigned int>(time(NULL));
+    }
+    g_gameManager->setSeed(seed);
     m_quit = false;
     
     // Get tilemap from asset manager
@@ -118,28 +106,28 @@ bool GameScene::initialize(SDL_Renderer* renderer) {
         g_worldWidth = m_tilemap.width * m_tilemap.tileWidth;
         g_worldHeight = m_tilemap.height * m_tilemap.tileHeight;
         m_camera.setLimits(0, 0, g_worldWidth, g_worldHeight);
+        g_gameManager->setTileSize(m_tilemap.tileWidth, m_tilemap.tileHeight);
+        m_tilemapRenderer.initialize(renderer, g_assetManager->getTilemap());
     } else {
         // Fallback to screen size if no tilemap
         g_worldWidth = SCREEN_WIDTH;
         g_worldHeight = SCREEN_HEIGHT;
     }
     
-    // Initialize spatial partitioning grid
-    g_gridWidth = (g_worldWidth + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
-    g_gridHeight = (g_worldHeight + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
-    
-    // Clamp grid dimensions to maximum
-    if (g_gridWidth > MAX_GRID_WIDTH) g_gridWidth = MAX_GRID_WIDTH;
-    if (g_gridHeight > MAX_GRID_HEIGHT) g_gridHeight = MAX_GRID_HEIGHT;
-    
-    std::cout << "Spatial grid initialized: " << g_gridWidth << "x" << g_gridHeight << " cells" << std::endl;
-    
     // Initialize game manager with world bounds
     g_gameManager->initialize(g_worldWidth, g_worldHeight);
     
     // Center camera on player initially
     m_camera.centerOn(g_gameManager->getPlayer().getCenterX(), g_gameManager->getPlayer().getCenterY());
     
+    // Start the simulation clock
+    m_clock.reset();
+    m_paused = false;
+    m_timeScale = 1.0f;
+    updateSpeedLabel();
+    m_lastFrameCounter = SDL_GetPerformanceCounter();
+    m_tickAccumulator = 0.0;
+    
     return true;
 }
 
@@ -162,50 +150,117 @@ void GameScene::handleEvent(const SDL_Event& event) {
                 m_quit = true;
                 break;
             case SDLK_j:
-                g_gameManager->getPlayer().handleAttack();
+                // Applied at the start of the next simulation tick
+                m_attackQueued = true;
+                break;
+            case SDLK_p:
+                m_paused = !m_paused;
+                break;
+            case SDLK_LEFTBRACKET:
+                m_timeScale = std::max(MIN_TIME_SCALE, m_timeScale * 0.5f);
+                updateSpeedLabel();
+                break;
+            case SDLK_RIGHTBRACKET:
+                m_timeScale = std::min(MAX_TIME_SCALE, m_timeScale * 2.0f);
+                updateSpeedLabel();
                 break;
         }
     }
 }
 
 void GameScene::update() {
-    // Get current time first
-    Uint32 currentTime = SDL_GetTicks();
+    // Accumulate real time since the last frame
+    Uint64 now = SDL_GetPerformanceCounter();
+    double frameTime = (now - m_lastFrameCounter) * 1000.0 / SDL_GetPerformanceFrequency();
+    m_lastFrameCounter = now;
+    if (m_paused) return;
+    m_tickAccumulator += std::min(frameTime, MAX_FRAME_TIME_MS) * m_timeScale;
+    
+    // Run as many fixed ticks as the accumulated time covers
+    double tickDuration = m_clock.getTickDuration();
+    int ticks = 0;
+    while (m_tickAccumulator >= tickDuration && ticks < MAX_TICKS_PER_FRAME) {
+        runSimulationTick();
+        m_tickAccumulator -= tickDuration;
+        ticks++;
+    }
+    
+    // Drop time we could not catch up on rather than falling further behind
+    if (ticks == MAX_TICKS_PER_FRAME && m_tickAccumulator >= tickDuration) {
+        m_tickAccumulator = 0.0;
+    }
+    
+    m_renderAlpha = static_cast<float>(m_tickAccumulator / tickDuration);
+}
+
+void GameScene::runSimulationTick() {
+    const FrameTime& time = m_clock.advance();
+    
+    // Positions at the start of the tick are what render interpolates from
+    g_gameManager->savePreviousPositions();
+    
+    if (m_attackQueued) {
+        g_gameManager->getPlayer().handleAttack(time);
+        m_attackQueued = false;
+    }
     
     // Handle continuous movement with keyboard state
     const Uint8* keystate = SDL_GetKeyboardState(NULL);
-    g_gameManager->getPlayer().handleInput(keystate);
+    g_gameManager->getPlayer().handleInput(keystate, time.stepScale);
     
     // Update all game entities
-    g_gameManager->update(currentTime);
-    
-    // Update camera to follow player
-    m_camera.update(g_gameManager->getPlayer().getCenterX(), g_gameManager->getPlayer().getCenterY());
+    g_gameManager->update(time);
 }
 
 void GameScene::render() {
+    FrameTime time = m_clock.getRenderTime(m_renderAlpha);
+    
+    // Camera follows the interpolated player position so it moves as smoothly as the sprites
+    const Player& player = g_gameManager->getPlayer();
+    m_camera.update(player.getRenderCenterX(m_renderAlpha), player.getRenderCenterY(m_renderAlpha));
+    
     // Rendering
     SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 255);
     SDL_RenderClear(m_renderer);
     
     // Render tilemap background with camera offset
     if (g_assetManager && g_assetManager->isTilemapLoaded()) {
-        g_assetManager->getTMXLoader().renderTilemap(m_renderer, g_assetManager->getTilemap(), m_camera.getOffsetX(), m_camera.getOffsetY(), 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+        m_tilemapRenderer.render(g_assetManager->getTilemap(), m_camera.getOffsetX(), m_camera.getOffsetY(), 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
     }
 
     // Render all game entities
-    g_gameManager->render(m_renderer, g_assetManager, m_camera.getOffsetX(), m_camera.getOffsetY());
+    g_gameManager->render(m_renderer, g_assetManager, m_camera.getViewport(), time);
 
     // Render score and enemy count
     SDL_Color white = {255, 255, 255, 255};
-    if (g_assetManager && g_assetManager->getFont()) {
-        renderText(m_renderer, g_assetManager->getFont(), "Shards: " + std::to_string(g_gameManager->getScore()), 10, 10, white);
-        renderText(m_renderer, g_assetManager->getFont(), "Enemies: " + std::to_string(g_gameManager->getEnemies().size()), 10, 30, white);
+    BitmapFont* font = g_assetManager ? g_assetManager->getFont() : nullptr;
+    if (font) {
+        m_scoreLabel.setNumber(g_gameManager->getScore());
+        m_enemyCountLabel.setNumber(static_cast<long long>(g_gameManager->getEnemies().size()));
+        
+        m_hudBatch.begin(m_renderer);
+        m_scoreLabel.render(m_hudBatch, *font, 10, 10, white);
+        m_enemyCountLabel.render(m_hudBatch, *font, 10, 30, white);
+        
+        // Playback state
+        if (m_paused) {
+            m_pausedLabel.render(m_hudBatch, *font, 10, 50, white);
+        } else if (m_timeScale != 1.0f) {
+            m_speedLabel.render(m_hudBatch, *font, 10, 50, white);
+        }
+        m_hudBatch.flush();
     }
 
     SDL_RenderPresent(m_renderer);
 }
 
+// Playback speed label: "Speed: x0.25", "Speed: x2", ...
+void GameScene::updateSpeedLabel() {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "Speed: x%g", m_timeScale);
+    m_speedLabel.setText(buffer);
+}
+
 void GameScene::restart() {
     // Reset game manager
     g_gameManager->reset();
@@ -214,6 +269,22 @@ void GameScene::restart() {
     std::cout << "Game restarted - all state reset" << std::endl;
 }
 
+void GameScene::handleRenderReset(bool deviceReset) {
+    // Chunks are rebuilt from the tilemap as they come back into view
+    if (deviceReset) {
+        m_tilemapRenderer.releaseTextures();
+        g_gameManager->releaseRenderTextures();
+    } else {
+        m_tilemapRenderer.invalidate();
+    }
+    std::cout << "Render " << (deviceReset ? "device" : "targets") << " reset - tilemap chunks will be rebuilt" << std::endl;
+}
+
+void GameScene::resumeTiming() {
+    m_lastFrameCounter = SDL_GetPerformanceCounter();
+    m_tickAccumulator = 0.0;
+}
+
 void GameScene::handleWindowResize(int newWidth, int newHeight) {
     // SDL's logical size and integer scaling handle this automatically
     // The renderer will automatically scale the logical size to fit the new window size
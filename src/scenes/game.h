@@ -3,7 +3,16 @@
 #include <string>
 #include "../utils/tmx_loader.h"
 #include "../rendering/camera.h"
+#include "../rendering/tilemap_renderer.h"
+#include "../rendering/sprite_batch.h"
+#include "../rendering/text_label.h"
 #include "../entities/player.h"
+#include "../systems/settings.h"
+#include "../systems/frame_clock.h"
+
+// Forward declarations
+class JobSystem;
+class Scenario;
 
 class GameScene {
 public:
@@ -11,7 +20,8 @@ public:
     ~GameScene();
     
     // Initialize the game scene
-    bool initialize(SDL_Renderer* renderer);
+    // jobs is shared with the scene manager and must outlive the scene
+    bool initialize(SDL_Renderer* renderer, const Settings& settings, const Scenario& scenario, JobSystem* jobs);
     
     // Set character class for the player
     void setCharacterClass(CharacterClass characterClass);
@@ -32,6 +42,12 @@ public:
     // Handle window resize events
     void handleWindowResize(int newWidth, int newHeight);
     
+    // Render targets lost their contents (deviceReset: the textures themselves are gone)
+    void handleRenderReset(bool deviceReset);
+    
+    // Restart frame timing so time spent in other scenes isn't simulated
+    void resumeTiming();
+
 private:
     // Game state
     bool m_quit = false;
@@ -40,9 +56,38 @@ private:
     // Camera system
     Camera m_camera;
     
+    // Fixed-timestep simulation: real frame time (scaled by the playback
+    // speed) accumulates and is consumed in whole ticks; rendering blends the
+    // last two ticks by the remainder
+    FrameClock m_clock;
+    double m_tickAccumulator = 0.0; // milliseconds not yet simulated
+    Uint64 m_lastFrameCounter = 0;
+    float m_renderAlpha = 1.0f;
+    bool m_attackQueued = false;    // Attack key pressed since the last tick
+    
+    // Playback speed: P pauses, [ and ] halve and double the speed
+    bool m_paused = false;
+    float m_timeScale = 1.0f;
+    static constexpr float MIN_TIME_SCALE = 0.25f;
+    static constexpr float MAX_TIME_SCALE = 4.0f;
+    
+    static constexpr double MAX_FRAME_TIME_MS = 250.0; // Clamp after stalls to avoid a spiral of catch-up ticks
+    static constexpr int MAX_TICKS_PER_FRAME = 8;
+    
+    void runSimulationTick();
+    
     // Tilemap data
     TilemapData m_tilemap;
     TMXLoader m_tmxLoader;
+    TilemapRenderer m_tilemapRenderer; // Background drawn from cached chunk textures
+    
+    // HUD text, reformatted only when the value shown changes
+    SpriteBatch m_hudBatch;
+    TextLabel m_scoreLabel;
+    TextLabel m_enemyCountLabel;
+    TextLabel m_pausedLabel;
+    TextLabel m_speedLabel;
+    void updateSpeedLabel();
     
     // Game objects and state will be moved here from main.cpp
     // (This will be implemented in game.cpp)
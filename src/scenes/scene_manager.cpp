@@ -4,6 +4,8 @@
 SceneManager::SceneManager() {
     m_currentScene = SceneType::GAME;
     m_settings = new Settings();
+    m_scenario = new Scenario();
+    m_jobs = new JobSystem();
 }
 
 SceneManager::~SceneManager() {
@@ -19,6 +21,15 @@ SceneManager::~SceneManager() {
     if (m_settings) {
         delete m_settings;
     }
+    if (m_scenario) {
+        delete m_scenario;
+    }
+    
+    // Scenes are gone, so nothing can still be submitting jobs
+    if (m_jobs) {
+        m_jobs->shutdown();
+        delete m_jobs;
+    }
 }
 
 bool SceneManager::initialize(SDL_Renderer* renderer, SDL_Window* window) {
@@ -28,6 +39,10 @@ bool SceneManager::initialize(SDL_Renderer* renderer, SDL_Window* window) {
     // Load settings
     m_settings->loadFromFile();
     
+    // Load scenario; its character class is the default selection
+    m_scenario->loadFromFile();
+    m_selectedCharacterClass = m_scenario->getCharacterClass();
+    
     // Apply fullscreen setting on startup
     if (m_settings->isFullscreen()) {
         if (SDL_SetWindowFullscreen(m_window, SDL_WINDOW_FULLSCREEN_DESKTOP) == 0) {
@@ -37,9 +52,13 @@ bool SceneManager::initialize(SDL_Renderer* renderer, SDL_Window* window) {
         }
     }
     
+    // Start the worker threads (0 = one per hardware thread)
+    m_jobs->start(m_settings->getWorkerThreads());
+    std::cout << "Job system threads: " << m_jobs->getThreadCount() << std::endl;
+    
     // Initialize game scene
     m_gameScene = new GameScene();
-    if (!m_gameScene->initialize(renderer)) {
+    if (!m_gameScene->initialize(renderer, *m_settings, *m_scenario, m_jobs)) {
         std::cerr << "Failed to initialize game scene" << std::endl;
         return false;
     }
@@ -78,6 +97,14 @@ void SceneManager::handleEvent(const SDL_Event& event) {
         return;
     }
     
+    // Cached render-target textures need rebuilding whichever scene is showing
+    if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+        if (m_gameScene) {
+            m_gameScene->handleRenderReset(event.type == SDL_RENDER_DEVICE_RESET);
+        }
+        return;
+    }
+    
     // Handle F1 key to toggle menu (only from game scene)
     if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F1) {
         if (m_currentScene == SceneType::GAME) {
@@ -165,6 +192,7 @@ void SceneManager::switchToGame() {
     // Set the player's character class
     if (m_gameScene) {
         m_gameScene->setCharacterClass(m_selectedCharacterClass);
+        m_gameScene->resumeTiming();
     }
     
     std::cout << "Switched to game scene" << std::endl;
@@ -4,6 +4,8 @@
 #include "menu_scene.h"
 #include "player_select_scene.h"
 #include "../systems/settings.h"
+#include "../systems/scenario.h"
+#include "../systems/job_system.h"
 
 enum class SceneType {
     GAME,
@@ -43,6 +45,12 @@ private:
     // Settings
     Settings* m_settings = nullptr;
     
+    // Load profile for the game (scenario.txt, read-only)
+    Scenario* m_scenario = nullptr;
+    
+    // Worker threads shared by the scenes' systems; outlives every scene
+    JobSystem* m_jobs = nullptr;
+    
     // Character class selection
     CharacterClass m_selectedCharacterClass = CharacterClass::SWORDSMAN;
     
@@ -0,0 +1,144 @@
+#include "collision_world.h"
+#include <algorithm>
+#include <cmath>
+
+CollisionWorld::CollisionWorld() : m_enemies(nullptr), m_maxEnemySize(0) {
+}
+
+CollisionWorld::~CollisionWorld() {
+    // Cleanup handled by member destructors
+}
+
+void CollisionWorld::initialize(int cellSize, int expectedEntries) {
+    m_grid.initialize(cellSize, expectedEntries);
+    m_enemies = nullptr;
+    m_maxEnemySize = 0;
+}
+
+void CollisionWorld::rebuild(const EnemyStore& enemies) {
+    m_enemies = &enemies;
+    m_maxEnemySize = 0;
+    
+    m_grid.clear();
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (!enemies.isActive(i)) continue;
+        
+        m_grid.insert(static_cast<int>(i), enemies.getCenterX(i), enemies.getCenterY(i));
+        m_maxEnemySize = std::max(m_maxEnemySize, enemies.getSize(i));
+    }
+    m_grid.build();
+}
+
+void CollisionWorld::queryRect(const SDL_Rect& rect, std::vector<int>& out) const {
+    out.clear();
+    if (!m_enemies || rect.w <= 0 || rect.h <= 0) return;
+    
+    // Any enemy touching the rect has its centre within half an enemy of it.
+    // Enemies only shrink between rebuilds, so the indexed maximum still bounds them.
+    int reach = m_maxEnemySize / 2 + 1;
+    m_grid.queryArea(rect.x - reach, rect.y - reach, rect.x + rect.w + reach, rect.y + rect.h + reach, out);
+    
+    // Exact test against current enemy state
+    out.erase(std::remove_if(out.begin(), out.end(), [&](int index) {
+        return !m_enemies->checkCollision(static_cast<size_t>(index), rect);
+    }), out.end());
+    std::sort(out.begin(), out.end());
+}
+
+void CollisionWorld::queryCandidates(const SDL_Rect& rect, std::vector<int>& out) const {
+    out.clear();
+    if (!m_enemies || rect.w <= 0 || rect.h <= 0) return;
+    
+    int reach = m_maxEnemySize / 2 + 1;
+    m_grid.queryArea(rect.x - reach, rect.y - reach, rect.x + rect.w + reach, rect.y + rect.h + reach, out);
+    std::sort(out.begin(), out.end());
+}
+
+void CollisionWorld::queryRadius(int x, int y, float radius, std::vector<int>& out) const {
+    out.clear();
+    if (!m_enemies || radius < 0) return;
+    
+    int reach = static_cast<int>(std::ceil(radius)) + m_maxEnemySize;
+    m_grid.queryNeighbors(x, y, reach, out);
+    
+    out.erase(std::remove_if(out.begin(), out.end(), [&](int index) {
+        size_t i = static_cast<size_t>(index);
+        if (!m_enemies->isActive(i)) return true;
+        
+        float dx = m_enemies->getCenterX(i) - x;
+        float dy = m_enemies->getCenterY(i) - y;
+        return sqrt(dx * dx + dy * dy) > radius;
+    }), out.end());
+    std::sort(out.begin(), out.end());
+}
+
+int CollisionWorld::nearest(int x, int y, float maxRange) const {
+    Neighbor best;
+    return searchRings(x, y, 1, maxRange, &best) > 0 ? best.index : -1;
+}
+
+void CollisionWorld::kNearest(int x, int y, int k, float maxRange, std::vector<int>& out) const {
+    out.clear();
+    if (k <= 0) return;
+    
+    if (m_kNearestScratch.size() < static_cast<size_t>(k)) {
+        m_kNearestScratch.resize(k);
+    }
+    int found = searchRings(x, y, k, maxRange, m_kNearestScratch.data());
+    for (int i = 0; i < found; i++) {
+        out.push_back(m_kNearestScratch[i].index);
+    }
+}
+
+int CollisionWorld::searchRings(int x, int y, int k, float maxRange, Neighbor* best) const {
+    int found = 0;
+    if (!m_enemies || maxRange <= 0 || m_grid.getEntryCount() == 0) return found;
+    
+    int cellSize = m_grid.getCellSize();
+    int originX = m_grid.getCellCoord(x);
+    int originY = m_grid.getCellCoord(y);
+    
+    // Centres can drift by up to half an enemy from where they were indexed
+    // (enemies shrink when damaged), so ring bounds are loosened by that much
+    float slack = m_maxEnemySize / 2.0f;
+    int maxRing = static_cast<int>(std::ceil((maxRange + slack) / cellSize)) + 1;
+    
+    auto visit = [&](int index) {
+        size_t i = static_cast<size_t>(index);
+        if (!m_enemies->isActive(i)) return;
+        
+        float dx = m_enemies->getCenterX(i) - x;
+        float dy = m_enemies->getCenterY(i) - y;
+        Neighbor candidate = {static_cast<float>(sqrt(dx * dx + dy * dy)), index};
+        if (candidate.distance >= maxRange) return;
+        if (found == k && !(candidate < best[k - 1])) return;
+        
+        // Insert in order, dropping the farthest once k are held
+        if (found < k) found++;
+        int slot = found - 1;
+        while (slot > 0 && candidate < best[slot - 1]) {
+            best[slot] = best[slot - 1];
+            slot--;
+        }
+        best[slot] = candidate;
+    };
+    
+    for (int ring = 0; ring <= maxRing; ring++) {
+        // Walk only the cells on this ring's perimeter
+        for (int cellY = originY - ring; cellY <= originY + ring; cellY++) {
+            bool edgeRow = (cellY == originY - ring || cellY == originY + ring);
+            int step = edgeRow ? 1 : 2 * ring;
+            for (int cellX = originX - ring; cellX <= originX + ring; cellX += std::max(1, step)) {
+                m_grid.forEachInCell(cellX, cellY, visit);
+            }
+        }
+        
+        // Anything not yet visited lies outside the scanned square; stop once
+        // the square's nearest edge is farther than the current k-th best
+        float reach = std::min(std::min(x - (originX - ring) * cellSize, (originX + ring + 1) * cellSize - x),
+                               std::min(y - (originY - ring) * cellSize, (originY + ring + 1) * cellSize - y)) - slack;
+        if (reach >= maxRange) break;
+        if (found == k && reach > best[k - 1].distance) break;
+    }
+    return found;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "spatial_grid.h"
+#include "../entities/enemy_store.h"
+
+// Broadphase for combat collisions and targeting against enemies.
+// Enemy centres are bucketed into a spatial grid once per tick (after enemies
+// have moved and spawned); queries gather the nearby candidates and then run
+// the same exact tests the old brute-force loops used against the live store.
+// Hits recorded earlier in the tick but not yet applied are accounted for by
+// CombatBuffer's filters.
+// Results are sorted by enemy index, matching the old iteration order.
+class CollisionWorld {
+public:
+    CollisionWorld();
+    ~CollisionWorld();
+    
+    // Set cell size and expected enemy count
+    void initialize(int cellSize, int expectedEntries);
+    
+    // Re-index all active enemies; call after enemy positions change
+    void rebuild(const EnemyStore& enemies);
+    
+    // Active enemies whose rect intersects rect (same rule as SDL_HasIntersection)
+    void queryRect(const SDL_Rect& rect, std::vector<int>& out) const;
+    
+    // Enemies indexed (at the last rebuild) near rect: every one whose rect
+    // overlapped it then, plus some that didn't. Sorted by index. Doesn't read
+    // the store, so it works after the store is compacted - map the indices.
+    void queryCandidates(const SDL_Rect& rect, std::vector<int>& out) const;
+    
+    // Active enemies whose centre is within radius of (x, y), inclusive
+    void queryRadius(int x, int y, float radius, std::vector<int>& out) const;
+    
+    // Nearest active enemy whose centre is closer than maxRange, or -1.
+    // Equal distances resolve to the lower index.
+    int nearest(int x, int y, float maxRange) const;
+    
+    // Up to k nearest active enemies closer than maxRange, nearest first.
+    // Uses a scratch buffer owned by the world, so calls must not overlap.
+    void kNearest(int x, int y, int k, float maxRange, std::vector<int>& out) const;
+    
+    // Getters
+    int getIndexedCount() const { return m_grid.getEntryCount(); }
+    int getMaxEnemySize() const { return m_maxEnemySize; }
+
+private:
+    struct Neighbor {
+        float distance;
+        int index;
+        bool operator<(const Neighbor& other) const {
+            return distance < other.distance || (distance == other.distance && index < other.index);
+        }
+    };
+    
+    // Ring search shared by nearest/kNearest: fills best (room for k) with the
+    // closest enemies found, sorted, and returns how many there are
+    int searchRings(int x, int y, int k, float maxRange, Neighbor* best) const;
+    
+    SpatialGrid m_grid;
+    const EnemyStore* m_enemies;
+    mutable std::vector<Neighbor> m_kNearestScratch; // Reused by kNearest so queries don't allocate
+    
+    // Largest enemy size at rebuild time; rect queries widen their search by
+    // half of it because enemies are indexed by centre
+    int m_maxEnemySize;
+};
@@ -0,0 +1,104 @@
+#include "combat_buffer.h"
+#include "../entities/enemy.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+CombatBuffer::CombatBuffer() : m_hitCount(0), m_killCount(0) {
+    m_hits.reserve(64);
+    m_deaths.reserve(32);
+}
+
+CombatBuffer::~CombatBuffer() {
+    // Cleanup handled by vector destructors
+}
+
+void CombatBuffer::begin(const EnemyStore& enemies) {
+    m_hits.clear();
+    m_deaths.clear();
+    m_pendingDamage.assign(enemies.size(), 0);
+}
+
+void CombatBuffer::addHit(int target, float knockbackX, float knockbackY, float knockbackDistance, HitSource source) {
+    HitRecord hit;
+    hit.target = target;
+    hit.sequence = static_cast<int>(m_hits.size());
+    hit.knockbackX = knockbackX;
+    hit.knockbackY = knockbackY;
+    hit.knockbackDistance = knockbackDistance;
+    hit.source = source;
+    m_hits.push_back(hit);
+    m_pendingDamage[target]++;
+}
+
+bool CombatBuffer::isAlive(const EnemyStore& enemies, size_t i) const {
+    return enemies.isActive(i) && enemies.getLevel(i) - m_pendingDamage[i] > 0;
+}
+
+int CombatBuffer::getSize(const EnemyStore& enemies, size_t i) const {
+    int pending = m_pendingDamage[i];
+    return pending == 0 ? enemies.getSize(i) : Enemy::getEnemySize(enemies.getLevel(i) - pending);
+}
+
+void CombatBuffer::filterRect(const EnemyStore& enemies, const SDL_Rect& rect, std::vector<int>& hits) const {
+    hits.erase(std::remove_if(hits.begin(), hits.end(), [&](int index) {
+        size_t i = static_cast<size_t>(index);
+        if (m_pendingDamage[i] == 0) return false;
+        if (!isAlive(enemies, i)) return true;
+        
+        // Same overlap rule as EnemyStore::checkCollision, at the pending size
+        int size = getSize(enemies, i);
+        int x = enemies.getX(i);
+        int y = enemies.getY(i);
+        return !(x < rect.x + rect.w && x + size > rect.x && y < rect.y + rect.h && y + size > rect.y);
+    }), hits.end());
+}
+
+void CombatBuffer::filterRadius(const EnemyStore& enemies, int x, int y, float radius, std::vector<int>& hits) const {
+    hits.erase(std::remove_if(hits.begin(), hits.end(), [&](int index) {
+        size_t i = static_cast<size_t>(index);
+        if (!isAlive(enemies, i)) return true;
+        
+        // Same distance test as CollisionWorld::queryRadius, at the pending centre
+        float dx = getCenterX(enemies, i) - x;
+        float dy = getCenterY(enemies, i) - y;
+        return sqrt(dx * dx + dy * dy) > radius;
+    }), hits.end());
+}
+
+void CombatBuffer::apply(EnemyStore& enemies, ItemStore& items, Uint32 currentTime, Random& dropRandom) {
+    if (m_hits.empty()) return;
+    
+    // Group by target, keeping each enemy's hits in detection order
+    std::stable_sort(m_hits.begin(), m_hits.end(), [](const HitRecord& a, const HitRecord& b) {
+        return a.target < b.target;
+    });
+    
+    for (const HitRecord& hit : m_hits) {
+        size_t i = static_cast<size_t>(hit.target);
+        bool wasActive = enemies.isActive(i);
+        
+        enemies.takeDamage(i);
+        enemies.applyKnockback(i, hit.knockbackX, hit.knockbackY, hit.knockbackDistance, currentTime);
+        
+        if (wasActive && !enemies.isActive(i)) {
+            m_deaths.push_back({hit.sequence, hit.target, hit.source});
+        }
+        m_pendingDamage[i]--;
+    }
+    m_hitCount += static_cast<int>(m_hits.size());
+    m_hits.clear();
+    
+    // Deaths and item drops in the order the killing hits happened
+    std::sort(m_deaths.begin(), m_deaths.end(), [](const Death& a, const Death& b) {
+        return a.sequence < b.sequence;
+    });
+    for (const Death& death : m_deaths) {
+        if (death.source == HitSource::EXPLOSION) {
+            std::cout << "Enemy killed by explosion!" << std::endl;
+        }
+        Enemy::handleDeath(enemies, static_cast<size_t>(death.target), items, currentTime, dropRandom);
+    }
+    m_killCount += static_cast<int>(m_deaths.size());
+    m_deaths.clear();
+}
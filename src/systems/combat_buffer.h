@@ -0,0 +1,83 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "../entities/enemy_store.h"
+#include "../entities/item_store.h"
+#include "../utils/random.h"
+
+enum class HitSource : Uint8 {
+    MELEE,
+    PROJECTILE,
+    EXPLOSION
+};
+
+// One hit on an enemy, as recorded by collision detection
+struct HitRecord {
+    int target;           // Enemy index
+    int sequence;         // Detection order within the tick
+    float knockbackX;     // Arguments for EnemyStore::applyKnockback
+    float knockbackY;
+    float knockbackDistance;
+    HitSource source;
+};
+
+// Per-tick command buffer for combat.
+// Detection passes only read the enemy store and record hits here; apply()
+// then sorts the records by target (stably, so each enemy takes its hits in
+// detection order) and applies damage, knockback, deaths and drops in one
+// pass. Deaths are handled in the order the killing hits were detected, so
+// drops consume the random stream exactly as immediate application did.
+//
+// Until apply(), detection must see enemies as if their recorded hits had
+// already landed (a killed enemy can't be hit again, a damaged one is
+// smaller). The pending-state getters and the filters below provide that
+// view on top of the unmodified store.
+class CombatBuffer {
+public:
+    CombatBuffer();
+    ~CombatBuffer();
+    
+    // Start a tick's detection against enemies (drops any unapplied hits)
+    void begin(const EnemyStore& enemies);
+    
+    // Record a hit; knockback arguments are passed to applyKnockback unchanged
+    // (a distance of 0 means no knockback)
+    void addHit(int target, float knockbackX, float knockbackY, float knockbackDistance, HitSource source);
+    
+    // Enemy state with the recorded hits counted
+    bool isAlive(const EnemyStore& enemies, size_t i) const;
+    int getSize(const EnemyStore& enemies, size_t i) const;
+    int getCenterX(const EnemyStore& enemies, size_t i) const { return enemies.getX(i) + getSize(enemies, i) / 2; }
+    int getCenterY(const EnemyStore& enemies, size_t i) const { return enemies.getY(i) + getSize(enemies, i) / 2; }
+    
+    // Narrow CollisionWorld results to the pending view. Enemies only shrink,
+    // so a queryRect result is already a superset; a queryRadius must be
+    // widened by the largest enemy size, because centres move as enemies shrink.
+    void filterRect(const EnemyStore& enemies, const SDL_Rect& rect, std::vector<int>& hits) const;
+    void filterRadius(const EnemyStore& enemies, int x, int y, float radius, std::vector<int>& hits) const;
+    
+    // Apply every recorded hit and clear the buffer
+    void apply(EnemyStore& enemies, ItemStore& items, Uint32 currentTime, Random& dropRandom);
+    
+    // Getters
+    int getPendingHitCount() const { return static_cast<int>(m_hits.size()); }
+    
+    // Counters
+    int getHitCount() const { return m_hitCount; }
+    int getKillCount() const { return m_killCount; }
+    void resetCounters() { m_hitCount = 0; m_killCount = 0; }
+
+private:
+    struct Death {
+        int sequence;
+        int target;
+        HitSource source;
+    };
+    
+    std::vector<HitRecord> m_hits;
+    std::vector<Death> m_deaths;
+    std::vector<int> m_pendingDamage; // Recorded hits per enemy, indexed like the store
+    
+    int m_hitCount;
+    int m_killCount;
+};
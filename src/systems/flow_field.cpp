@@ -0,0 +1,199 @@
+#include "flow_field.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+FlowField::FlowField()
+    : m_tilesWide(0), m_tilesHigh(0), m_tileWidth(1), m_tileHeight(1),
+      m_windowRadius(0), m_windowSize(1), m_targetTileX(0), m_targetTileY(0), m_rebuildCount(0),
+      m_integrationCount(0), m_blockedCount(0), m_tilesChanged(false), m_windowOpen(true), m_searchStride(0) {
+}
+
+FlowField::~FlowField() {
+    // Cleanup handled by vector destructor
+}
+
+void FlowField::initialize(int worldWidth, int worldHeight, int tileWidth, int tileHeight, int windowRadius) {
+    m_tileWidth = std::max(1, tileWidth);
+    m_tileHeight = std::max(1, tileHeight);
+    m_tilesWide = (worldWidth + m_tileWidth - 1) / m_tileWidth;
+    m_tilesHigh = (worldHeight + m_tileHeight - 1) / m_tileHeight;
+    m_windowRadius = std::max(2, windowRadius);
+    m_windowSize = m_windowRadius * 2 + 1;
+    m_targetTileX = -1;
+    m_targetTileY = -1;
+    m_rebuildCount = 0;
+    m_integrationCount = 0;
+    
+    m_blocked.assign(m_tilesWide * m_tilesHigh, 0);
+    m_blockedInRow.assign(m_tilesHigh, 0);
+    m_blockedCount = 0;
+    m_tilesChanged = false;
+    m_windowOpen = true;
+    
+    // Headings from each offset's tile centre to the target tile's centre.
+    // Both centres are the same distance from their tile corners, so the
+    // heading is just the negated offset in pixels, normalized.
+    int cells = m_windowSize * m_windowSize;
+    m_offsetDirections.assign(cells * 2, 0.0f);
+    for (int offsetY = -m_windowRadius; offsetY <= m_windowRadius; offsetY++) {
+        for (int offsetX = -m_windowRadius; offsetX <= m_windowRadius; offsetX++) {
+            float dx = static_cast<float>(-offsetX * m_tileWidth);
+            float dy = static_cast<float>(-offsetY * m_tileHeight);
+            float length = std::sqrt(dx * dx + dy * dy);
+            if (length <= 0.0f) continue;
+            
+            int cell = (offsetY + m_windowRadius) * m_windowSize + (offsetX + m_windowRadius);
+            m_offsetDirections[cell * 2] = dx / length;
+            m_offsetDirections[cell * 2 + 1] = dy / length;
+        }
+    }
+    
+    // Integration field storage, used only once a tile is blocked
+    m_searchStride = m_windowSize + 2;
+    int searchCells = m_searchStride * m_searchStride;
+    m_open.assign(searchCells, 0);
+    m_cost.assign(searchCells, UNREACHABLE);
+    m_lineOfSight.assign(searchCells, 0);
+    m_queue.clear();
+    m_queue.reserve(cells);
+    m_directions.assign(cells * 2, 0.0f);
+}
+
+void FlowField::setBlocked(int tileX, int tileY, bool blocked) {
+    if (tileX < 0 || tileY < 0 || tileX >= m_tilesWide || tileY >= m_tilesHigh) return;
+    Uint8& tile = m_blocked[tileY * m_tilesWide + tileX];
+    if (tile == (blocked ? 1 : 0)) return;
+    tile = blocked ? 1 : 0;
+    m_blockedInRow[tileY] += blocked ? 1 : -1;
+    m_blockedCount += blocked ? 1 : -1;
+    m_tilesChanged = true;
+}
+
+bool FlowField::isBlocked(int tileX, int tileY) const {
+    if (tileX < 0 || tileY < 0 || tileX >= m_tilesWide || tileY >= m_tilesHigh) return false;
+    return m_blocked[tileY * m_tilesWide + tileX] != 0;
+}
+
+bool FlowField::setTarget(int x, int y) {
+    int tileX = std::max(0, std::min(m_tilesWide - 1, x / m_tileWidth));
+    int tileY = std::max(0, std::min(m_tilesHigh - 1, y / m_tileHeight));
+    if (tileX == m_targetTileX && tileY == m_targetTileY && !m_tilesChanged) return false;
+    
+    m_targetTileX = tileX;
+    m_targetTileY = tileY;
+    m_tilesChanged = false;
+    m_rebuildCount++;
+    
+    // An open window only moves; one with blocked tiles needs a search
+    m_windowOpen = !windowHasBlockedTiles();
+    if (!m_windowOpen) {
+        integrate();
+        m_integrationCount++;
+    }
+    return true;
+}
+
+bool FlowField::windowHasBlockedTiles() const {
+    if (m_blockedCount == 0) return false;
+    int minX = std::max(0, m_targetTileX - m_windowRadius);
+    int maxX = std::min(m_tilesWide - 1, m_targetTileX + m_windowRadius);
+    int minY = std::max(0, m_targetTileY - m_windowRadius);
+    int maxY = std::min(m_tilesHigh - 1, m_targetTileY + m_windowRadius);
+    for (int tileY = minY; tileY <= maxY; tileY++) {
+        if (m_blockedInRow[tileY] == 0) continue;
+        const Uint8* row = &m_blocked[tileY * m_tilesWide];
+        if (std::memchr(row + minX, 1, maxX - minX + 1)) return true;
+    }
+    return false;
+}
+
+void FlowField::integrate() {
+    const int stride = m_searchStride;
+    const int radius = m_windowRadius;
+    const int size = m_windowSize;
+    
+    // Open tiles of the window; the border and anything outside the world
+    // stay closed. The target tile counts as open even if blocked.
+    std::fill(m_open.begin(), m_open.end(), 0);
+    for (int cellY = 0; cellY < size; cellY++) {
+        int tileY = m_targetTileY - radius + cellY;
+        if (tileY < 0 || tileY >= m_tilesHigh) continue;
+        int minCellX = std::max(0, radius - m_targetTileX);
+        int maxCellX = std::min(size - 1, m_tilesWide - 1 - m_targetTileX + radius);
+        const Uint8* blocked = &m_blocked[tileY * m_tilesWide + m_targetTileX - radius];
+        Uint8* open = &m_open[(cellY + 1) * stride + 1];
+        for (int cellX = minCellX; cellX <= maxCellX; cellX++) {
+            open[cellX] = blocked[cellX] ? 0 : 1;
+        }
+    }
+    int targetCell = (radius + 1) * stride + (radius + 1);
+    m_open[targetCell] = 1;
+    
+    // Steps from the target tile, four-connected
+    std::fill(m_cost.begin(), m_cost.end(), UNREACHABLE);
+    m_queue.clear();
+    m_cost[targetCell] = 0;
+    m_queue.push_back(targetCell);
+    const int steps[4] = {1, -1, stride, -stride};
+    for (size_t head = 0; head < m_queue.size(); head++) {
+        int cell = m_queue[head];
+        Uint16 nextCost = static_cast<Uint16>(m_cost[cell] + 1);
+        for (int step : steps) {
+            int next = cell + step;
+            if (m_cost[next] != UNREACHABLE || !m_open[next]) continue;
+            m_cost[next] = nextCost;
+            m_queue.push_back(next);
+        }
+    }
+    
+    // Line of sight to the target tile, working outward from it one quadrant
+    // at a time: a tile sees the target if it is reachable and its neighbours
+    // one step closer on each axis do. That is conservative next to corners,
+    // which only means a few more tiles follow the field instead.
+    for (int signY = -1; signY <= 1; signY += 2) {
+        for (int signX = -1; signX <= 1; signX += 2) {
+            for (int stepsY = 0; stepsY <= radius; stepsY++) {
+                int rowStart = targetCell + signY * stepsY * stride;
+                for (int stepsX = 0; stepsX <= radius; stepsX++) {
+                    int cell = rowStart + signX * stepsX;
+                    bool visible = m_cost[cell] != UNREACHABLE &&
+                                   (stepsX == 0 || m_lineOfSight[cell - signX]) &&
+                                   (stepsY == 0 || m_lineOfSight[cell - signY * stride]);
+                    m_lineOfSight[cell] = visible ? 1 : 0;
+                }
+            }
+        }
+    }
+    
+    // Headings: straight at the target where it is in sight, otherwise
+    // toward the cheapest neighbour (diagonals only past two open sides, so
+    // nothing cuts a blocked corner)
+    const float diagonal = 0.70710678f;
+    for (int cellY = 0; cellY < size; cellY++) {
+        for (int cellX = 0; cellX < size; cellX++) {
+            int cell = cellY * size + cellX;
+            int searchCell = (cellY + 1) * stride + (cellX + 1);
+            float dirX = 0.0f;
+            float dirY = 0.0f;
+            if (m_lineOfSight[searchCell]) {
+                dirX = m_offsetDirections[cell * 2];
+                dirY = m_offsetDirections[cell * 2 + 1];
+            } else if (m_cost[searchCell] != UNREACHABLE) {
+                Uint16 best = m_cost[searchCell];
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        Uint16 cost = m_cost[searchCell + dy * stride + dx];
+                        if (cost >= best) continue;
+                        if (dx != 0 && dy != 0 && (!m_open[searchCell + dx] || !m_open[searchCell + dy * stride])) continue;
+                        best = cost;
+                        dirX = (dy == 0) ? static_cast<float>(dx) : dx * diagonal;
+                        dirY = (dx == 0) ? static_cast<float>(dy) : dy * diagonal;
+                    }
+                }
+            }
+            m_directions[cell * 2] = dirX;
+            m_directions[cell * 2 + 1] = dirY;
+        }
+    }
+}
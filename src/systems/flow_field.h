@@ -0,0 +1,104 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// Pursuit direction field over the tilemap grid.
+// Every tile in a square window around the target's tile stores a unit
+// heading toward the target, so an enemy finds its way with one table lookup
+// instead of a sqrt and a divide.
+//
+// Tiles can be marked blocked. When the window holds none, every heading is
+// the straight line from the tile's centre to the target tile's centre, which
+// depends only on the tile's offset from the target: that table is built once
+// and moving the target only moves the window. Otherwise the window gets an
+// integration field: a breadth-first search from the target tile gives each
+// open tile its step count, tiles with a clear line to the target keep the
+// straight heading, and the rest head for their cheapest neighbour. That
+// field is rebuilt only when the target changes tile or tiles change.
+class FlowField {
+public:
+    FlowField();
+    ~FlowField();
+    
+    // Tile grid of the world, and how many tiles the window reaches in each
+    // direction from the target tile. Every tile starts open.
+    void initialize(int worldWidth, int worldHeight, int tileWidth, int tileHeight, int windowRadius);
+    
+    // Mark a tile as blocking movement; takes effect at the next setTarget()
+    void setBlocked(int tileX, int tileY, bool blocked);
+    bool isBlocked(int tileX, int tileY) const;
+    
+    // Point the field at a world position. Returns true if the field changed
+    // (the target moved to a different tile, or tiles were blocked or opened).
+    bool setTarget(int x, int y);
+    
+    // Heading toward the target for a world position. Returns false (leaving
+    // dirX/dirY untouched) outside the window, on tiles with no path to the
+    // target, and within a tile of the target, where tile-sized steps are too
+    // coarse and callers should seek directly.
+    bool sample(int x, int y, float& dirX, float& dirY) const {
+        if (x < 0 || y < 0) return false;
+        int offsetX = x / m_tileWidth - m_targetTileX;
+        int offsetY = y / m_tileHeight - m_targetTileY;
+        if (offsetX < -m_windowRadius || offsetX > m_windowRadius ||
+            offsetY < -m_windowRadius || offsetY > m_windowRadius) {
+            return false;
+        }
+        if (offsetX >= -1 && offsetX <= 1 && offsetY >= -1 && offsetY <= 1) return false;
+        
+        int cell = (offsetY + m_windowRadius) * m_windowSize + (offsetX + m_windowRadius);
+        const float* directions = m_offsetDirections.data();
+        if (!m_windowOpen) {
+            int searchCell = (offsetY + m_windowRadius + 1) * m_searchStride + (offsetX + m_windowRadius + 1);
+            if (m_cost[searchCell] == UNREACHABLE) return false;
+            directions = m_directions.data();
+        }
+        dirX = directions[cell * 2];
+        dirY = directions[cell * 2 + 1];
+        return true;
+    }
+    
+    // Counters
+    int getRebuildCount() const { return m_rebuildCount; }
+    int getIntegrationCount() const { return m_integrationCount; }
+    int getWindowRadius() const { return m_windowRadius; }
+
+private:
+    int m_tilesWide;
+    int m_tilesHigh;
+    int m_tileWidth;
+    int m_tileHeight;
+    int m_windowRadius;
+    int m_windowSize;
+    
+    int m_targetTileX;
+    int m_targetTileY;
+    int m_rebuildCount;     // Target tile changes (or tile edits) applied
+    int m_integrationCount; // Of those, the ones that needed a search
+    
+    // Blocked flag per world tile, row-major, and how many are set per row
+    std::vector<Uint8> m_blocked;
+    std::vector<int> m_blockedInRow;
+    int m_blockedCount;
+    bool m_tilesChanged;
+    bool m_windowOpen; // No blocked tile in the window: headings come from m_offsetDirections
+    
+    // Interleaved unit directions (x, y) toward the target for each offset in
+    // the window, row-major; the headings whenever the window is open
+    std::vector<float> m_offsetDirections;
+    
+    // Integration field for windows with blocked tiles. The search arrays
+    // cover the window plus a one-tile border that is never open, so
+    // neighbour steps need no bounds checks; m_directions has the same layout
+    // as m_offsetDirections.
+    static constexpr Uint16 UNREACHABLE = 0xFFFF;
+    int m_searchStride;
+    std::vector<Uint8> m_open;
+    std::vector<Uint16> m_cost; // Steps from the target tile
+    std::vector<Uint8> m_lineOfSight;
+    std::vector<int> m_queue;
+    std::vector<float> m_directions;
+    
+    bool windowHasBlockedTiles() const;
+    void integrate();
+};
@@ -0,0 +1,38 @@
+#include "frame_clock.h"
+#include <algorithm>
+
+FrameClock::FrameClock() : m_tickRate(BASE_TICK_RATE), m_simTime(0.0) {
+    setTickRate(BASE_TICK_RATE);
+}
+
+FrameClock::~FrameClock() {
+    // Nothing to clean up
+}
+
+void FrameClock::setTickRate(int ticksPerSecond) {
+    m_tickRate = std::max(1, ticksPerSecond);
+    m_tickTime.dt = static_cast<float>(getTickDuration());
+    m_tickTime.stepScale = static_cast<float>(BASE_TICK_RATE) / m_tickRate;
+}
+
+void FrameClock::reset() {
+    m_simTime = 0.0;
+    m_tickTime.tick = 0;
+    m_tickTime.simTime = 0;
+}
+
+const FrameTime& FrameClock::advance() {
+    m_simTime += getTickDuration();
+    m_tickTime.tick++;
+    m_tickTime.simTime = static_cast<Uint32>(m_simTime);
+    m_tickTime.alpha = 1.0f;
+    return m_tickTime;
+}
+
+FrameTime FrameClock::getRenderTime(float alpha) const {
+    FrameTime renderTime = m_tickTime;
+    renderTime.alpha = alpha;
+    double previousTime = std::max(0.0, m_simTime - getTickDuration());
+    renderTime.simTime = static_cast<Uint32>(previousTime + (m_simTime - previousTime) * alpha);
+    return renderTime;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <SDL.h>
+
+// Simulation time for one tick, or for one rendered frame between two ticks.
+// FrameClock creates it and it is passed down through every update and render
+// call, so everything in a frame sees the same time and nothing in the
+// simulation reads the wall clock.
+struct FrameTime {
+    Uint64 tick = 0;        // Ticks simulated so far, including this one
+    Uint32 simTime = 0;     // Simulated milliseconds at the end of this tick
+    float dt = 0.0f;        // Tick length in simulated milliseconds
+    float stepScale = 1.0f; // dt relative to a 60 Hz tick (per-tick speeds are tuned for 60 Hz)
+    float alpha = 1.0f;     // Rendering only: blend from the previous tick (0) to this one (1)
+};
+
+// Fixed-rate simulation clock. Simulated time only moves when advance() is
+// called, so callers decide how it relates to real time: the game feeds it
+// from an accumulator (which is where pause and slow/fast motion live) and
+// the headless runner ticks it as fast as it can.
+class FrameClock {
+public:
+    FrameClock();
+    ~FrameClock();
+    
+    // Ticks per second; movement is scaled so speeds match the original 60 Hz tuning
+    static constexpr int BASE_TICK_RATE = 60;
+    void setTickRate(int ticksPerSecond);
+    int getTickRate() const { return m_tickRate; }
+    double getTickDuration() const { return 1000.0 / m_tickRate; }
+    
+    // Back to tick 0 at time 0
+    void reset();
+    
+    // Step to the next tick and return its time
+    const FrameTime& advance();
+    
+    // Time of the last tick
+    const FrameTime& getTickTime() const { return m_tickTime; }
+    
+    // Time for rendering alpha of the way from the previous tick to the last one
+    FrameTime getRenderTime(float alpha) const;
+
+private:
+    int m_tickRate;
+    double m_simTime; // Exact milliseconds (tick lengths need not be whole)
+    FrameTime m_tickTime;
+};
@@ -2,27 +2,43 @@
 #include "asset_manager.h"
 #include <algorithm>
 #include <cmath>
-#include <cstdlib>
 #include <iostream>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 GameManager::GameManager() 
-    : m_lastEnemySpawn(0), m_magnetEffectEndTime(0), 
+    : m_seed(1), m_lastEnemySpawn(0), m_magnetEffectEndTime(0), 
       m_worldWidth(0), m_worldHeight(0) {
-    m_enemies.reserve(Enemy::MAX_ENEMIES);
-    m_items.reserve(Item::MAX_SHARDS + Item::MAX_MAGNETS);
+    m_items.initialize(Item::MAX_ITEMS);
+    m_itemHits.reserve(16);
+    m_shardCoalescer.initialize(SHARD_MERGE_CELL_SIZE, Item::MAX_SHARDS);
+    m_explosions.reserve(MAX_EXPLOSIONS);
+    m_explosionCenters.reserve(MAX_EXPLOSIONS);
+    m_explosionRadii.reserve(MAX_EXPLOSIONS);
+    reserveEnemyCapacity();
+    m_collisionHits.reserve(64);
+    
+    // Player and pet shots share one projectile store
+    m_projectiles.initialize(ProjectileSystem::MAX_PROJECTILES);
+    m_player.setProjectileSystem(&m_projectiles);
+    
+    // Enemy level labels never change, so each is formatted once here
+    for (int level = 1; level <= Enemy::MAX_ENEMY_LEVEL; level++) {
+        m_levelLabels[level - 1].setNumber(level);
+    }
+    
+    // Single-threaded until a job system is provided
+    setJobSystem(nullptr);
+    
+    std::cout << "Separation kernel: " << getSimdLevelName(getSimdLevel()) << std::endl;
 }
 
 GameManager::~GameManager() {
-    // Cleanup handled by destructors
+    // The job system belongs to the caller
 }
 
 void GameManager::initialize(int worldWidth, int worldHeight) {
     m_worldWidth = worldWidth;
     m_worldHeight = worldHeight;
+    m_flowField.initialize(worldWidth, worldHeight, m_tileWidth, m_tileHeight, FLOW_FIELD_RADIUS_TILES);
     
     // Initialize player at world center
     m_player.initialize(worldWidth / 2 - Player::PLAYER_SIZE / 2, worldHeight / 2 - Player::PLAYER_SIZE / 2);
@@ -31,101 +47,287 @@ void GameManager::initialize(int worldWidth, int worldHeight) {
     m_pet.initialize(worldWidth / 2 - Pet::SIZE / 2 + 30, worldHeight / 2 - Pet::SIZE / 2 + 30);
     
     // Clear all entities
+    m_projectiles.clear();
     m_enemies.clear();
     m_items.clear();
+    m_enemyRemap.clear(); // The collision index is stale until the next tick
+    
+    // Same seed, same run
+    reseedStreams();
     
     // Reset game state
     m_lastEnemySpawn = 0;
     m_magnetEffectEndTime = 0;
 }
 
-void GameManager::update(Uint32 currentTime) {
-    // Update player
-    m_player.update();
+void GameManager::setTileSize(int tileWidth, int tileHeight) {
+    m_tileWidth = tileWidth > 0 ? tileWidth : DEFAULT_TILE_SIZE;
+    m_tileHeight = tileHeight > 0 ? tileHeight : DEFAULT_TILE_SIZE;
+}
+
+void GameManager::setJobSystem(JobSystem* jobs) {
+    m_jobs = jobs ? jobs : &m_inlineJobs;
+    
+    size_t threadCount = static_cast<size_t>(m_jobs->getThreadCount());
+    if (m_enemyStepScratch.size() == threadCount) return;
+    
+    m_enemyStepScratch.resize(threadCount);
+    for (auto& scratch : m_enemyStepScratch) {
+        scratch.nearbyEnemies.reserve(64);
+        scratch.separationCandidates.centerX.reserve(64);
+        scratch.separationCandidates.centerY.reserve(64);
+        scratch.separationCandidates.radius.reserve(64);
+    }
+}
+
+void GameManager::setScenario(const Scenario& scenario) {
+    m_scenario = scenario;
+    reserveEnemyCapacity();
+    
+    // Full fidelity covers the scenario's spawn area, however wide
+    m_simulationLod.setDefaultBands(scenario.getSpawnAreaWidth(), scenario.getSpawnAreaHeight());
+}
+
+void GameManager::reserveEnemyCapacity() {
+    int maxEnemies = m_scenario.getMaxEnemies();
+    m_enemies.reserve(maxEnemies);
+    // Cells as wide as the largest avoidance range, so a 3x3 cell query
+    // around any enemy covers every neighbour that can push it
+    m_enemyGrid.initialize(Enemy::getMaxAvoidanceRange(), maxEnemies);
+    m_collisionWorld.initialize(COLLISION_CELL_SIZE, maxEnemies);
+}
+
+void GameManager::savePreviousPositions() {
+    m_player.savePreviousPosition();
+    m_pet.savePreviousPosition();
+    m_projectiles.snapshotPositions();
+    m_enemies.snapshotPositions();
+    m_items.snapshotPositions();
+}
+
+void GameManager::setSeed(uint64_t seed) {
+    m_seed = seed;
+    reseedStreams();
+    std::cout << "Random seed: " << m_seed << std::endl;
+}
+
+void GameManager::reseedStreams() {
+    Random root(m_seed);
+    m_spawnRandom = root.substream(1);
+    m_dropRandom = root.substream(2);
+}
+
+void GameManager::resetPhaseTimings() {
+    for (auto& counter : m_phaseCounters) {
+        counter = 0;
+    }
+    m_simulationLod.resetStats();
+}
+
+double GameManager::getPhaseTime(UpdatePhase phase) const {
+    return static_cast<double>(m_phaseCounters[static_cast<int>(phase)]) / SDL_GetPerformanceFrequency();
+}
+
+const char* GameManager::getPhaseName(UpdatePhase phase) {
+    switch (phase) {
+        case UpdatePhase::PLAYER: return "player";
+        case UpdatePhase::PET: return "pet";
+        case UpdatePhase::ENEMIES: return "enemies";
+        case UpdatePhase::ITEMS: return "items";
+        case UpdatePhase::SPAWN: return "spawn";
+        case UpdatePhase::COLLISIONS: return "collisions";
+        case UpdatePhase::PROJECTILES: return "projectiles";
+        case UpdatePhase::EXPLOSIONS: return "explosions";
+        case UpdatePhase::CLEANUP: return "cleanup";
+        default: return "unknown";
+    }
+}
+
+void GameManager::endPhase(UpdatePhase phase, Uint64& phaseStart) {
+    if (!m_profilingEnabled) return;
     
-    // Update pet
-    m_pet.update(m_player, m_enemies, currentTime);
+    Uint64 now = SDL_GetPerformanceCounter();
+    m_phaseCounters[static_cast<int>(phase)] += now - phaseStart;
+    phaseStart = now;
+}
+
+void GameManager::logPoolUsage() const {
+    auto logPool = [](const char* name, int highWater, int capacity, int failed) {
+        std::cout << "  " << name << ": " << highWater << " / " << capacity;
+        if (failed > 0) {
+            std::cout << " (" << failed << " rejected)";
+        }
+        std::cout << std::endl;
+    };
     
-    // Handle pet projectile collisions
-    m_pet.handleProjectileCollisions(m_enemies, m_items, currentTime);
+    std::cout << "Pool usage (high-water / capacity):" << std::endl;
+    logPool("projectiles", m_projectiles.getHighWater(), m_projectiles.getCapacity(), m_projectiles.getFailedSpawns());
+    logPool("items", m_items.getHighWater(), m_items.getCapacity(), m_items.getFailedAdds());
+    logPool("explosions", m_explosionHighWater, MAX_EXPLOSIONS, m_failedExplosions);
+    std::cout << "  shards merged: " << m_shardCoalescer.getMergedCount() << std::endl;
+    std::cout << "  combat: " << m_combat.getHitCount() << " hits, " << m_combat.getKillCount() << " kills" << std::endl;
+}
+
+void GameManager::update(const FrameTime& time) {
+    Uint64 phaseStart = m_profilingEnabled ? SDL_GetPerformanceCounter() : 0;
+    Uint32 currentTime = time.simTime;
+    
+    // Update player
+    m_player.update(time);
+    endPhase(UpdatePhase::PLAYER, phaseStart);
     
-    // Update enemies and items
-    updateEnemies(currentTime);
-    updateItems(currentTime);
+    // Update enemies
+    updateEnemies(time);
+    endPhase(UpdatePhase::ENEMIES, phaseStart);
     
     // Spawn new enemies
-    spawnEnemies(currentTime);
+    spawnEnemies(time);
+    endPhase(UpdatePhase::SPAWN, phaseStart);
+    
+    // Enemies are done moving for this tick - index them for every combat query below
+    m_collisionWorld.rebuild(m_enemies);
+    m_combat.begin(m_enemies);
+    endPhase(UpdatePhase::COLLISIONS, phaseStart);
+    
+    // Update pet (its shots join the projectile store)
+    m_pet.update(m_player, m_collisionWorld, m_enemies, m_projectiles, time);
+    endPhase(UpdatePhase::PET, phaseStart);
+    
+    // Update items
+    updateItems(time);
+    endPhase(UpdatePhase::ITEMS, phaseStart);
     
     // Handle all collisions
-    handleCollisions(currentTime);
+    handleCollisions();
+    endPhase(UpdatePhase::COLLISIONS, phaseStart);
     
-    // Handle projectile collisions
-    handleProjectileCollisions(currentTime);
+    // Move projectiles, detonate fuses and record direct hits
+    handleProjectileCollisions(time);
+    endPhase(UpdatePhase::PROJECTILES, phaseStart);
+    
+    // Apply the tick's hits: damage, knockback, deaths and drops
+    m_combat.apply(m_enemies, m_items, currentTime, m_dropRandom);
+    endPhase(UpdatePhase::COLLISIONS, phaseStart);
     
     // Update explosions
     updateExplosions(currentTime);
+    endPhase(UpdatePhase::EXPLOSIONS, phaseStart);
     
     // Cleanup inactive entities
     cleanupInactiveEntities();
+    endPhase(UpdatePhase::CLEANUP, phaseStart);
 }
 
-void GameManager::render(SDL_Renderer* renderer, AssetManager* assetManager, int cameraOffsetX, int cameraOffsetY) {
+void GameManager::render(SDL_Renderer* renderer, AssetManager* assetManager, const SDL_Rect& viewport, const FrameTime& time) {
+    BitmapFont* font = assetManager ? assetManager->getFont() : nullptr;
+    int cameraOffsetX = -viewport.x;
+    int cameraOffsetY = -viewport.y;
+    m_spriteBatch.begin(renderer);
+    
     // Render player
     SDL_Texture* playerTexture = nullptr;
     if (assetManager) {
         playerTexture = assetManager->getPlayerTexture();
     }
-    m_player.render(renderer, playerTexture, cameraOffsetX, cameraOffsetY);
+    m_player.render(m_spriteBatch, playerTexture, cameraOffsetX, cameraOffsetY, time);
     
     // Render player attack
     if (m_player.getAttack().active) {
         SDL_Rect attackRect = m_player.getAttack().rect;
         attackRect.x += cameraOffsetX;
         attackRect.y += cameraOffsetY;
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-        SDL_RenderFillRect(renderer, &attackRect);
+        m_spriteBatch.fillRect(attackRect, {255, 0, 0, 255});
     }
     
-    // Render player projectiles
-    m_player.renderProjectiles(renderer, cameraOffsetX, cameraOffsetY);
-    
-    // Render projectile timers with font
-    renderProjectileTimers(renderer, assetManager, cameraOffsetX, cameraOffsetY);
-    
     // Render pet
     if (m_pet.isActive()) {
         SDL_Texture* petTexture = nullptr;
         if (assetManager) {
             petTexture = assetManager->getPetTexture();
         }
-        m_pet.render(renderer, petTexture, cameraOffsetX, cameraOffsetY);
-        m_pet.renderProjectiles(renderer, cameraOffsetX, cameraOffsetY);
+        m_pet.render(m_spriteBatch, petTexture, cameraOffsetX, cameraOffsetY, time);
     }
     
-    // Render enemies
-    for (const auto& enemy : m_enemies) {
-        if (enemy.isActive()) {
-            SDL_Texture* enemyTexture = nullptr;
-            if (assetManager) {
-                enemyTexture = assetManager->getEnemyTexture(enemy.getLevel());
-            }
-            enemy.render(renderer, enemyTexture, cameraOffsetX, cameraOffsetY, assetManager->getFont());
+    // Render player and pet projectiles
+    int projectilesDrawn = m_projectiles.render(m_spriteBatch, viewport, time, font);
+    m_renderedCount = projectilesDrawn;
+    m_culledCount = m_projectiles.getActiveCount() - projectilesDrawn;
+    
+    // Render on-screen enemies, then their level labels over all of them
+    collectVisibleEnemies(viewport, time);
+    for (int i : m_visibleEnemies) {
+        SDL_Texture* enemyTexture = nullptr;
+        if (assetManager) {
+            enemyTexture = assetManager->getEnemyTexture(m_enemies.getLevel(i));
         }
+        Enemy::render(m_enemies, i, m_spriteBatch, enemyTexture, cameraOffsetX, cameraOffsetY, time);
+    }
+    for (int i : m_visibleEnemies) {
+        Enemy::renderLabel(m_enemies, i, m_spriteBatch, font, m_levelLabels, cameraOffsetX, cameraOffsetY, time);
+    }
+    m_renderedCount += static_cast<int>(m_visibleEnemies.size());
+    m_culledCount += static_cast<int>(m_enemies.getActiveCount() - m_visibleEnemies.size());
+    
+    // Render on-screen items
+    collectVisibleItems(viewport, time);
+    for (int i : m_visibleItems) {
+        Item::render(m_items, i, m_spriteBatch, cameraOffsetX, cameraOffsetY, time);
     }
+    m_renderedCount += static_cast<int>(m_visibleItems.size());
+    m_culledCount += m_items.getActiveCount() - static_cast<int>(m_visibleItems.size());
+    
+    // Render explosions (flushes the batch)
+    int explosionsDrawn = renderExplosions(renderer, viewport, time);
+    m_renderedCount += explosionsDrawn;
+    m_culledCount += static_cast<int>(m_explosions.size()) - explosionsDrawn;
+}
+
+void GameManager::releaseRenderTextures() {
+    m_explosionRenderer.releaseTextures();
+}
+
+void GameManager::collectVisibleEnemies(const SDL_Rect& viewport, const FrameTime& time) {
+    m_visibleEnemies.clear();
     
-    // Render items
-    for (const auto& item : m_items) {
-        if (item.isActive()) {
-            item.render(renderer, cameraOffsetX, cameraOffsetY);
+    // Candidates near the view as of the last index, mapped to today's
+    // indices, then tested at their interpolated position
+    SDL_Rect searchRect = {viewport.x - RENDER_CULL_MARGIN, viewport.y - RENDER_CULL_MARGIN,
+                           viewport.w + 2 * RENDER_CULL_MARGIN, viewport.h + 2 * RENDER_CULL_MARGIN};
+    m_collisionWorld.queryCandidates(searchRect, m_collisionHits);
+    for (int candidate : m_collisionHits) {
+        if (candidate >= static_cast<int>(m_enemyRemap.size())) continue;
+        int i = m_enemyRemap[candidate];
+        if (i < 0 || i >= static_cast<int>(m_enemies.size()) || !m_enemies.isActive(i)) continue;
+        
+        int size = m_enemies.getSize(i);
+        SDL_Rect rect = {interpolatePosition(m_enemies.getPrevX(i), m_enemies.getX(i), time.alpha),
+                         interpolatePosition(m_enemies.getPrevY(i), m_enemies.getY(i), time.alpha), size, size};
+        if (SDL_HasIntersection(&rect, &viewport)) {
+            m_visibleEnemies.push_back(i);
         }
     }
+}
+
+void GameManager::collectVisibleItems(const SDL_Rect& viewport, const FrameTime& time) {
+    SDL_Rect searchRect = {viewport.x - RENDER_CULL_MARGIN, viewport.y - RENDER_CULL_MARGIN,
+                           viewport.w + 2 * RENDER_CULL_MARGIN, viewport.h + 2 * RENDER_CULL_MARGIN};
+    m_items.refreshIndex();
+    m_items.queryRect(searchRect, m_visibleItems);
     
-    // Render explosions
-    renderExplosions(renderer, cameraOffsetX, cameraOffsetY);
+    size_t kept = 0;
+    for (int i : m_visibleItems) {
+        int size = m_items.getSize(i);
+        SDL_Rect rect = {interpolatePosition(m_items.getPrevX(i), m_items.getX(i), time.alpha),
+                         interpolatePosition(m_items.getPrevY(i), m_items.getY(i), time.alpha), size, size};
+        if (SDL_HasIntersection(&rect, &viewport)) {
+            m_visibleItems[kept++] = i;
+        }
+    }
+    m_visibleItems.resize(kept);
 }
 
-void GameManager::handleCollisions(Uint32 currentTime) {
-    handlePlayerAttackCollisions(currentTime);
+void GameManager::handleCollisions() {
+    handlePlayerAttackCollisions();
     handlePlayerEnemyCollisions();
 }
 
@@ -137,44 +339,58 @@ void GameManager::reset() {
     m_pet.initialize(m_worldWidth / 2 - Pet::SIZE / 2 + 30, m_worldHeight / 2 - Pet::SIZE / 2 + 30);
     
     // Clear all entities
+    m_projectiles.clear();
     m_enemies.clear();
     m_items.clear();
+    m_enemyRemap.clear(); // The collision index is stale until the next tick
+    
+    // Same seed, same run
+    reseedStreams();
     
     // Reset game state
     m_lastEnemySpawn = 0;
     m_magnetEffectEndTime = 0;
 }
 
-void GameManager::spawnEnemies(Uint32 currentTime) {
-    if (currentTime - m_lastEnemySpawn > Enemy::ENEMY_SPAWN_RATE && m_enemies.size() < Enemy::MAX_ENEMIES) {
-        // Calculate enemy level based on player's score
-        int enemyLevel = Enemy::calculateLevel(m_player.getScore());
-        
-        // Spawn enemy at viewport edges (not world boundaries)
+void GameManager::spawnEnemies(const FrameTime& time) {
+    Uint32 currentTime = time.simTime;
+    size_t maxEnemies = static_cast<size_t>(m_scenario.getMaxEnemies());
+    if (currentTime - m_lastEnemySpawn <= static_cast<Uint32>(m_scenario.getSpawnInterval()) ||
+        m_enemies.size() >= maxEnemies) {
+        return;
+    }
+    
+    // Calculate enemy level based on player's score
+    int enemyLevel = Enemy::calculateLevel(m_player.getScore(), m_scenario.getLevelStart(),
+                                           m_scenario.getScorePerLevel(), m_scenario.getLevelMax());
+    
+    // Spawn enemies just outside the area around the player (not at world boundaries)
+    int viewportWidth = m_scenario.getSpawnAreaWidth();
+    int viewportHeight = m_scenario.getSpawnAreaHeight();
+    int spawnDistance = m_scenario.getSpawnDistance(); // Distance outside the area to spawn
+    
+    for (int i = 0; i < m_scenario.getSpawnBurst() && m_enemies.size() < maxEnemies; i++) {
         int spawnX, spawnY;
-        int viewportWidth = 800;  // Game viewport width
-        int viewportHeight = 600; // Game viewport height
-        int spawnDistance = 100;  // Distance outside viewport to spawn
         
         // Choose random edge (0=top, 1=right, 2=bottom, 3=left)
-        int edge = rand() % 4;
+        int edge = m_spawnRandom.nextInt(4);
         
         switch (edge) {
             case 0: // Top edge - spawn above viewport
-                spawnX = m_player.getX() + (rand() % viewportWidth) - viewportWidth/2;
+                spawnX = m_player.getX() + m_spawnRandom.nextInt(viewportWidth) - viewportWidth/2;
                 spawnY = m_player.getY() - viewportHeight/2 - spawnDistance;
                 break;
             case 1: // Right edge - spawn to the right of viewport
                 spawnX = m_player.getX() + viewportWidth/2 + spawnDistance;
-                spawnY = m_player.getY() + (rand() % viewportHeight) - viewportHeight/2;
+                spawnY = m_player.getY() + m_spawnRandom.nextInt(viewportHeight) - viewportHeight/2;
                 break;
             case 2: // Bottom edge - spawn below viewport
-                spawnX = m_player.getX() + (rand() % viewportWidth) - viewportWidth/2;
+                spawnX = m_player.getX() + m_spawnRandom.nextInt(viewportWidth) - viewportWidth/2;
                 spawnY = m_player.getY() + viewportHeight/2 + spawnDistance;
                 break;
             case 3: // Left edge - spawn to the left of viewport
                 spawnX = m_player.getX() - viewportWidth/2 - spawnDistance;
-                spawnY = m_player.getY() + (rand() % viewportHeight) - viewportHeight/2;
+                spawnY = m_player.getY() + m_spawnRandom.nextInt(viewportHeight) - viewportHeight/2;
                 break;
         }
         
@@ -184,280 +400,258 @@ void GameManager::spawnEnemies(Uint32 currentTime) {
         if (spawnY < 0) spawnY = 0;
         if (spawnY >= m_worldHeight) spawnY = m_worldHeight - 1;
         
-        // Use Enemy factory method
-        Enemy newEnemy = Enemy::createEnemy(spawnX, spawnY, enemyLevel, Enemy::DEFAULT_SPEED, currentTime);
-        m_enemies.push_back(newEnemy);
-        m_lastEnemySpawn = currentTime;
+        // Spawned after this tick's step, so its position is current as of this tick
+        size_t index = m_enemies.add(spawnX, spawnY, enemyLevel, Enemy::DEFAULT_SPEED, currentTime);
+        m_enemies.setLastStepTick(index, time.tick);
     }
+    m_lastEnemySpawn = currentTime;
 }
 
-void GameManager::updateEnemies(Uint32 currentTime) {
-    for (auto& enemy : m_enemies) {
-        if (enemy.isActive()) {
-            enemy.update(m_player, m_enemies, m_worldWidth, m_worldHeight, currentTime);
+void GameManager::updateEnemies(const FrameTime& time) {
+    // Freeze this tick's starting positions; neighbours are read from them
+    // while each enemy writes only its own slot, so chunks can run in parallel
+    m_enemies.snapshotPositions();
+    rebuildEnemyGrid();
+    m_flowField.setTarget(m_player.getCenterX(), m_player.getCenterY());
+    
+    // Capture only what fits in std::function's inline buffer, so no heap allocation per tick
+    m_jobs->parallelFor(m_enemies.size(), ENEMY_CHUNK_SIZE, [this, &time](size_t begin, size_t end, int threadIndex) {
+        EnemyStepScratch& scratch = m_enemyStepScratch[threadIndex];
+        int queryRadius = m_enemyGrid.getCellSize();
+        int playerCenterX = m_player.getCenterX();
+        int playerCenterY = m_player.getCenterY();
+        
+        for (size_t i = begin; i < end; i++) {
+            if (!m_enemies.isActive(i)) continue;
+            
+            // Pick the LOD band by distance from the player; reduced bands
+            // step every interval ticks (staggered by the enemy's phase, or
+            // sooner if it has already waited that long after a band change)
+            // over every tick since the enemy's last step
+            int band = m_simulationLod.classify(m_enemies.getPrevCenterX(i) - playerCenterX,
+                                                m_enemies.getPrevCenterY(i) - playerCenterY);
+            const LodBand& lod = m_simulationLod.getBand(band);
+            LodBandStats& stats = scratch.lodStats[band];
+            stats.enemyTicks++;
+            
+            Uint64 elapsedTicks = time.tick - m_enemies.getLastStepTick(i);
+            bool due = elapsedTicks >= static_cast<Uint64>(lod.interval) ||
+                       (time.tick + m_enemies.getStepPhase(i)) % lod.interval == 0;
+            if (!due || elapsedTicks == 0) continue;
+            
+            Uint64 stepStart = m_profilingEnabled ? SDL_GetPerformanceCounter() : 0;
+            
+            // Only enemies in the surrounding cells can contribute separation
+            // force; bands without separation skip the query entirely
+            scratch.nearbyEnemies.clear();
+            if (lod.separation) {
+                m_enemyGrid.queryNeighbors(m_enemies.getPrevCenterX(i), m_enemies.getPrevCenterY(i),
+                                           queryRadius, scratch.nearbyEnemies);
+            }
+            
+            // An enemy never waits longer than its band's interval, so this cap
+            // only guards enemies added without a spawn tick
+            FrameTime stepTime = time;
+            if (elapsedTicks > 1) {
+                float steps = static_cast<float>(std::min<Uint64>(elapsedTicks, m_simulationLod.getMaxInterval()));
+                stepTime.dt *= steps;
+                stepTime.stepScale *= steps;
+            }
+            
+            Enemy::update(m_enemies, i, m_player, m_flowField, scratch.nearbyEnemies, scratch.separationCandidates,
+                          m_worldWidth, m_worldHeight, stepTime);
+            m_enemies.setLastStepTick(i, time.tick);
+            
+            stats.updates++;
+            if (m_profilingEnabled) {
+                stats.updateCounter += SDL_GetPerformanceCounter() - stepStart;
+            }
+        }
+    });
+    
+    // Merge the per-thread counters
+    for (auto& scratch : m_enemyStepScratch) {
+        for (int band = 0; band < m_simulationLod.getBandCount(); band++) {
+            m_simulationLod.addStats(band, scratch.lodStats[band]);
+            scratch.lodStats[band] = LodBandStats();
         }
     }
 }
 
-void GameManager::updateItems(Uint32 currentTime) {
-    bool magnetEffectActive = (currentTime < m_magnetEffectEndTime);
-    for (auto& item : m_items) {
-        if (item.isActive()) {
-            item.update(m_player.getCenterX(), m_player.getCenterY(), currentTime, magnetEffectActive);
-            
-            // Handle item collection
-            int playerScore = m_player.getScore();
-            Uint32 magnetEffectEndTime = m_magnetEffectEndTime;
-            if (item.handleCollection(m_player.getRect(), currentTime, playerScore, magnetEffectEndTime)) {
-                m_player.addScore(playerScore - m_player.getScore()); // Add the difference
-                m_magnetEffectEndTime = magnetEffectEndTime;
-            }
+void GameManager::rebuildEnemyGrid() {
+    m_enemyGrid.clear();
+    for (size_t i = 0; i < m_enemies.size(); i++) {
+        if (m_enemies.wasActive(i)) {
+            m_enemyGrid.insert(static_cast<int>(i), m_enemies.getPrevCenterX(i), m_enemies.getPrevCenterY(i));
+        }
+    }
+    m_enemyGrid.build();
+}
+
+void GameManager::updateItems(const FrameTime& time) {
+    Uint32 currentTime = time.simTime;
+    
+    // Pull every shard toward the player in one batch while the magnet is active
+    if (currentTime < m_magnetEffectEndTime) {
+        Item::applyMagnetPull(m_items, m_player.getCenterX(), m_player.getCenterY(), time.stepScale);
+    }
+    
+    // Handle item collection - only items in the player's cells can touch it
+    m_items.refreshIndex();
+    m_items.queryRect(m_player.getRect(), m_itemHits);
+    for (int i : m_itemHits) {
+        int playerScore = m_player.getScore();
+        Uint32 magnetEffectEndTime = m_magnetEffectEndTime;
+        if (Item::handleCollection(m_items, i, m_player.getRect(), currentTime, playerScore, magnetEffectEndTime)) {
+            m_player.addScore(playerScore - m_player.getScore()); // Add the difference
+            m_magnetEffectEndTime = magnetEffectEndTime;
         }
     }
 }
 
 void GameManager::cleanupInactiveEntities() {
-    // Remove inactive enemies
-    m_enemies.erase(
-        std::remove_if(m_enemies.begin(), m_enemies.end(),
-            [](const Enemy& enemy) { return !enemy.isActive(); }),
-        m_enemies.end()
-    );
-    
-    // Remove inactive items
-    m_items.erase(
-        std::remove_if(m_items.begin(), m_items.end(),
-            [](const Item& item) { return !item.isActive(); }),
-        m_items.end()
-    );
-}
-
-void GameManager::handlePlayerAttackCollisions(Uint32 currentTime) {
+    // Remove inactive enemies (the remap lets render use this tick's collision index)
+    m_enemies.removeInactive(&m_enemyRemap);
+    
+    // Merge shards down to the budget, then remove inactive items
+    m_shardCoalescer.coalesce(m_items);
+    m_items.removeInactive();
+}
+
+void GameManager::handlePlayerAttackCollisions() {
     if (!m_player.getAttack().active) return;
     
-    for (auto& enemy : m_enemies) {
-        if (enemy.isActive() && enemy.checkCollision(m_player.getAttack().rect)) {
-            // Enemy hit by attack
-            enemy.takeDamage();
-            
-            // Calculate knockback direction
-            float dx = enemy.getX() - m_player.getX();
-            float dy = enemy.getY() - m_player.getY();
-            float distance = sqrt(dx * dx + dy * dy);
-            enemy.applyKnockback(dx, dy, distance, currentTime);
-            
-            // Handle enemy death and item drops
-            if (!enemy.isActive()) {
-                enemy.handleDeath(m_items, currentTime);
-            }
-        }
+    const SDL_Rect& attackRect = m_player.getAttack().rect;
+    m_collisionWorld.queryRect(attackRect, m_collisionHits);
+    m_combat.filterRect(m_enemies, attackRect, m_collisionHits);
+    for (int hit : m_collisionHits) {
+        size_t i = static_cast<size_t>(hit);
+        
+        // Enemy hit by attack, knocked back away from the player
+        float dx = m_enemies.getX(i) - m_player.getX();
+        float dy = m_enemies.getY(i) - m_player.getY();
+        float distance = sqrt(dx * dx + dy * dy);
+        m_combat.addHit(hit, dx, dy, distance, HitSource::MELEE);
     }
 }
 
 
 void GameManager::handlePlayerEnemyCollisions() {
-    for (auto& enemy : m_enemies) {
-        if (enemy.isActive() && enemy.checkCollisionWithPlayer(m_player)) {
-            // Player hit by enemy - handle death
-            m_player.handleDeath();
-            m_player.respawn(m_worldWidth, m_worldHeight);
-            enemy.setActive(false);
-        }
+    // Respawning moves the player, so after each hit the remaining enemies
+    // (higher indices) are tested against the new player rect
+    size_t nextIndex = 0;
+    while (true) {
+        m_collisionWorld.queryRect(m_player.getRect(), m_collisionHits);
+        m_combat.filterRect(m_enemies, m_player.getRect(), m_collisionHits);
+        auto hit = std::lower_bound(m_collisionHits.begin(), m_collisionHits.end(), static_cast<int>(nextIndex));
+        if (hit == m_collisionHits.end()) break;
+        
+        // Player hit by enemy - handle death
+        size_t i = static_cast<size_t>(*hit);
+        m_player.handleDeath();
+        m_player.respawn(m_worldWidth, m_worldHeight);
+        m_enemies.setActive(i, false);
+        nextIndex = i + 1;
     }
 }
 
-void GameManager::handleProjectileCollisions(Uint32 currentTime) {
-    // Check each player projectile for collisions and explosions
-    for (auto& projectile : m_player.getProjectiles()) {
-        if (!projectile.isActive()) continue;
-        
-        // Check if projectile should explode or has already exploded
-        if (projectile.shouldExplode() || projectile.isExploded()) {
-            // Process explosion if it should explode but hasn't been processed yet
-            if (projectile.shouldExplode() && !projectile.isExploded()) {
-                // Handle explosion damage
-                handleExplosionDamage(projectile.getX(), projectile.getY(), projectile.getExplosionRadius());
-                std::cout << "Projectile exploded at (" << projectile.getX() << ", " << projectile.getY() << ") with radius " << projectile.getExplosionRadius() << std::endl;
-                
-                // Create explosion effect
-                if (projectile.getType() == ProjectileType::BOMB) {
-                    Explosion explosion;
-                    explosion.x = projectile.getX();
-                    explosion.y = projectile.getY();
-                    explosion.radius = projectile.getExplosionRadius();
-                    explosion.startTime = SDL_GetTicks();
-                    explosion.duration = 1000; // 1 second for better visibility
-                    explosion.active = true;
-                    m_explosions.push_back(explosion);
-                    std::cout << "Created explosion effect at (" << explosion.x << ", " << explosion.y << ") with radius " << explosion.radius << std::endl;
-                }
-                
-                // Mark projectile as exploded after processing
-                projectile.setExploded(true);
-            }
-        }
+void GameManager::handleProjectileCollisions(const FrameTime& time) {
+    Uint32 currentTime = time.simTime;
+    m_projectiles.update(time);
+    
+    // Fuses that ran out this tick
+    for (const Detonation& detonation : m_projectiles.getDetonations()) {
+        handleExplosionDamage(detonation.x, detonation.y, detonation.radius);
+        std::cout << "Projectile exploded at (" << detonation.x << ", " << detonation.y << ") with radius " << detonation.radius << std::endl;
         
-        // Check collision with enemies (for direct hit projectiles like arrows and bombs)
-        if (projectile.getType() == ProjectileType::ARROW || projectile.getType() == ProjectileType::BOMB) {
-            for (auto& enemy : m_enemies) {
-                if (enemy.isActive() && enemy.checkCollision(projectile.getRect())) {
-                    if (projectile.getType() == ProjectileType::ARROW) {
-                        // Direct hit - damage enemy
-                        enemy.takeDamage();
-                        
-                        // Calculate knockback direction
-                        float dx = enemy.getX() - projectile.getX();
-                        float dy = enemy.getY() - projectile.getY();
-                        float distance = sqrt(dx * dx + dy * dy);
-                        enemy.applyKnockback(dx, dy, distance, currentTime);
-                        
-                        // Handle enemy death and item drops
-                        if (!enemy.isActive()) {
-                            enemy.handleDeath(m_items, currentTime);
-                        }
-                        
-                        // Remove projectile on hit
-                        projectile.setActive(false);
-                    } else if (projectile.getType() == ProjectileType::BOMB) {
-                        // Bomb hit enemy - stop moving but keep timer running
-                        projectile.setStopped(true);
-                        std::cout << "Bomb hit enemy and stopped at (" << projectile.getX() << ", " << projectile.getY() << ") - waiting for timer" << std::endl;
-                    }
-                    break;
-                }
-            }
+        // Create explosion effect
+        if (!detonation.effect) continue;
+        if (static_cast<int>(m_explosions.size()) >= MAX_EXPLOSIONS) {
+            m_failedExplosions++;
+            continue;
         }
+        Explosion explosion;
+        explosion.x = detonation.x;
+        explosion.y = detonation.y;
+        explosion.radius = detonation.radius;
+        explosion.startTime = currentTime;
+        explosion.duration = 1000; // 1 second for better visibility
+        m_explosions.push_back(explosion);
+        m_explosionHighWater = std::max(m_explosionHighWater, static_cast<int>(m_explosions.size()));
+        std::cout << "Created explosion effect at (" << explosion.x << ", " << explosion.y << ") with radius " << explosion.radius << std::endl;
     }
     
-    // Remove exploded projectiles after processing
-    m_player.removeExplodedProjectiles();
+    // Direct hits (arrows and pet bolts) and bombs stopping against enemies
+    m_projectiles.handleEnemyHits(m_collisionWorld, m_enemies, m_combat);
+    m_projectiles.removeInactive();
 }
 
 void GameManager::handleExplosionDamage(int explosionX, int explosionY, float explosionRadius) {
     if (explosionRadius <= 0) return;
     
-    int enemiesHit = 0;
-    
-    // Check each enemy for explosion damage
-    for (auto& enemy : m_enemies) {
-        if (!enemy.isActive()) continue;
+    // Enemies whose centre lies within the explosion radius (the query is
+    // widened because enemies already hit this tick have shrunk)
+    m_collisionWorld.queryRadius(explosionX, explosionY, explosionRadius + m_collisionWorld.getMaxEnemySize(),
+                                 m_collisionHits);
+    m_combat.filterRadius(m_enemies, explosionX, explosionY, explosionRadius, m_collisionHits);
+    for (int hit : m_collisionHits) {
+        size_t i = static_cast<size_t>(hit);
         
         // Calculate distance from explosion center to enemy center
-        float dx = enemy.getCenterX() - explosionX;
-        float dy = enemy.getCenterY() - explosionY;
+        float dx = m_combat.getCenterX(m_enemies, i) - explosionX;
+        float dy = m_combat.getCenterY(m_enemies, i) - explosionY;
         float distance = sqrt(dx * dx + dy * dy);
         
-        // If enemy is within explosion radius, damage it
-        if (distance <= explosionRadius) {
-            enemiesHit++;
-            
-            // Damage enemy
-            enemy.takeDamage();
-            
-            // Apply knockback away from explosion center
-            if (distance > 0) {
-                float knockbackX = dx / distance;
-                float knockbackY = dy / distance;
-                enemy.applyKnockback(knockbackX, knockbackY, distance, SDL_GetTicks());
-            }
-            
-            // Handle enemy death and item drops
-            if (!enemy.isActive()) {
-                std::cout << "Enemy killed by explosion!" << std::endl;
-                enemy.handleDeath(m_items, SDL_GetTicks());
-            }
+        // Damage enemy, with knockback away from explosion center
+        if (distance > 0) {
+            m_combat.addHit(hit, dx / distance, dy / distance, distance, HitSource::EXPLOSION);
+        } else {
+            m_combat.addHit(hit, 0.0f, 0.0f, 0.0f, HitSource::EXPLOSION);
         }
     }
-    
 }
 
 void GameManager::updateExplosions(Uint32 currentTime) {
-    // Update explosion effects
-    for (auto& explosion : m_explosions) {
-        if (explosion.active && currentTime - explosion.startTime > explosion.duration) {
-            explosion.active = false;
+    // Drop finished explosions. Walking backwards, the last one (moved into
+    // a finished one's slot) has already been checked.
+    for (int i = static_cast<int>(m_explosions.size()) - 1; i >= 0; i--) {
+        if (currentTime - m_explosions[i].startTime > m_explosions[i].duration) {
+            m_explosions[i] = m_explosions.back();
+            m_explosions.pop_back();
         }
     }
-    
-    // Remove inactive explosions
-    m_explosions.erase(
-        std::remove_if(m_explosions.begin(), m_explosions.end(),
-            [](const Explosion& e) { return !e.active; }),
-        m_explosions.end()
-    );
 }
 
-void GameManager::renderExplosions(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY) {
+int GameManager::renderExplosions(SDL_Renderer* renderer, const SDL_Rect& viewport, const FrameTime& time) {
+    m_explosionCenters.clear();
+    m_explosionRadii.clear();
     for (const auto& explosion : m_explosions) {
-        if (!explosion.active) continue;
+        // Skip explosions whose full circle is off-screen
+        int reach = static_cast<int>(std::ceil(explosion.radius)) + 1;
+        SDL_Rect bounds = {explosion.x - reach, explosion.y - reach, 2 * reach, 2 * reach};
+        if (!SDL_HasIntersection(&bounds, &viewport)) continue;
         
         // Calculate explosion progress (0.0 to 1.0)
-        Uint32 currentTime = SDL_GetTicks();
-        float progress = static_cast<float>(currentTime - explosion.startTime) / explosion.duration;
+        // (render time trails the last tick, so it can be just before the start)
+        Uint32 elapsed = (time.simTime > explosion.startTime) ? time.simTime - explosion.startTime : 0;
+        float progress = static_cast<float>(elapsed) / explosion.duration;
         if (progress > 1.0f) progress = 1.0f;
         
         // Calculate current radius (grows from 0 to full radius)
         float currentRadius = explosion.radius * progress;
+        SDL_Point center = {explosion.x - viewport.x, explosion.y - viewport.y};
         
-        // Draw explosion circle
-        int centerX = explosion.x + cameraOffsetX;
-        int centerY = explosion.y + cameraOffsetY;
-        
-        // Draw a simple filled circle for better visibility
-        SDL_SetRenderDrawColor(renderer, 255, 100, 0, 150); // Orange with transparency
-        
-        // Draw filled circle using multiple concentric circles
-        for (int r = 0; r < static_cast<int>(currentRadius); r += 2) {
-            int segments = 16;
-            for (int j = 0; j < segments; j++) {
-                float angle1 = (2.0f * M_PI * j) / segments;
-                float angle2 = (2.0f * M_PI * (j + 1)) / segments;
-                
-                int x1 = centerX + static_cast<int>(r * cos(angle1));
-                int y1 = centerY + static_cast<int>(r * sin(angle1));
-                int x2 = centerX + static_cast<int>(r * cos(angle2));
-                int y2 = centerY + static_cast<int>(r * sin(angle2));
-                
-                SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
-            }
-        }
-        
-        // Draw outer circle outline
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255); // Yellow outline
-        int segments = 32;
-        for (int j = 0; j < segments; j++) {
-            float angle1 = (2.0f * M_PI * j) / segments;
-            float angle2 = (2.0f * M_PI * (j + 1)) / segments;
-            
-            int x1 = centerX + static_cast<int>(currentRadius * cos(angle1));
-            int y1 = centerY + static_cast<int>(currentRadius * sin(angle1));
-            int x2 = centerX + static_cast<int>(currentRadius * cos(angle2));
-            int y2 = centerY + static_cast<int>(currentRadius * sin(angle2));
-            
-            SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
-        }
+        // Gradient disc, batched with the entities
+        m_explosionRenderer.renderFill(m_spriteBatch, renderer, center.x, center.y, currentRadius);
+        m_explosionCenters.push_back(center);
+        m_explosionRadii.push_back(currentRadius);
     }
-}
-
-void GameManager::renderProjectileTimers(SDL_Renderer* renderer, AssetManager* assetManager, int cameraOffsetX, int cameraOffsetY) {
-    if (!assetManager || !assetManager->getFont()) return;
+    m_spriteBatch.flush();
     
-    for (const auto& projectile : m_player.getProjectiles()) {
-        if (!projectile.isActive() || projectile.isExploded() || projectile.getType() != ProjectileType::BOMB) continue;
-        
-        // Get timer text
-        std::string timerText = projectile.getTimerText();
-        if (timerText.empty()) continue;
-        
-        // Calculate position above the projectile
-        int timerX = projectile.getX() + projectile.getSize() / 2 + cameraOffsetX;
-        int timerY = projectile.getY() - 20 + cameraOffsetY;
-        
-        // Set text color (white)
-        SDL_Color textColor = {255, 255, 255, 255};
-        
-        // Render the timer text using bitmap font
-        assetManager->getFont()->renderText(renderer, timerText, timerX - 10, timerY - 5, textColor);
+    // Outlines on top, drawn directly
+    for (size_t i = 0; i < m_explosionCenters.size(); i++) {
+        m_explosionRenderer.renderOutline(renderer, m_explosionCenters[i].x, m_explosionCenters[i].y, m_explosionRadii[i]);
     }
+    return static_cast<int>(m_explosionCenters.size());
 }
 
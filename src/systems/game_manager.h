@@ -4,12 +4,41 @@
 #include "../entities/entity.h"
 #include "../entities/player.h"
 #include "../entities/enemy.h"
+#include "../entities/enemy_store.h"
 #include "../entities/pet.h"
 #include "../entities/item.h"
+#include "spatial_grid.h"
+#include "collision_world.h"
+#include "combat_buffer.h"
+#include "frame_clock.h"
+#include "simulation_lod.h"
+#include "flow_field.h"
+#include "shard_coalescer.h"
+#include "projectile_system.h"
+#include "job_system.h"
+#include "scenario.h"
+#include "../rendering/sprite_batch.h"
+#include "../rendering/text_label.h"
+#include "../rendering/explosion_renderer.h"
+#include "../utils/random.h"
 
 // Forward declarations
 class AssetManager;
 
+// Sections of GameManager::update that are timed when profiling is enabled
+enum class UpdatePhase {
+    PLAYER,
+    PET,
+    ENEMIES,
+    ITEMS,
+    SPAWN,
+    COLLISIONS,
+    PROJECTILES,
+    EXPLOSIONS,
+    CLEANUP,
+    COUNT
+};
+
 class GameManager {
 public:
     GameManager();
@@ -18,24 +47,72 @@ public:
     // Initialize game manager
     void initialize(int worldWidth, int worldHeight);
     
-    // Update all game entities
-    void update(Uint32 currentTime);
+    // Tile size of the world's tilemap (the flow field's grid); set before initialize()
+    void setTileSize(int tileWidth, int tileHeight);
+    
+    // Job system for the enemy step (owned by the caller and must outlive this
+    // manager); nullptr runs everything on the calling thread
+    void setJobSystem(JobSystem* jobs);
+    int getWorkerThreads() const { return m_jobs->getThreadCount(); }
+    
+    // Enemy cap, spawn rate and level curve; resizes the enemy buffers and
+    // resets the LOD bands to fit the spawn area, so set it before
+    // initialize() (and before any custom setBands())
+    void setScenario(const Scenario& scenario);
+    const Scenario& getScenario() const { return m_scenario; }
+    
+    // Remember current positions as the start of the next tick (for render interpolation)
+    void savePreviousPositions();
+    
+    // Seed for all gameplay randomness; applied on initialize() and reset()
+    void setSeed(uint64_t seed);
+    uint64_t getSeed() const { return m_seed; }
+    
+    // Per-phase update timing (accumulated seconds since the last reset)
+    void setProfilingEnabled(bool enabled) { m_profilingEnabled = enabled; }
+    void resetPhaseTimings();
+    double getPhaseTime(UpdatePhase phase) const;
+    static const char* getPhaseName(UpdatePhase phase);
     
-    // Render all game entities
-    void render(SDL_Renderer* renderer, AssetManager* assetManager, int cameraOffsetX, int cameraOffsetY);
+    // Distance bands for the enemy step (configure before running; counters
+    // time spent per band only while profiling is enabled)
+    SimulationLod& getSimulationLod() { return m_simulationLod; }
+    const SimulationLod& getSimulationLod() const { return m_simulationLod; }
+    
+    // Advance the simulation by one fixed tick (time comes from FrameClock::advance)
+    void update(const FrameTime& time);
+    
+    // Render the game entities inside viewport (the camera's rect in world
+    // coordinates), time.alpha (0..1) blending the last two ticks
+    void render(SDL_Renderer* renderer, AssetManager* assetManager, const SDL_Rect& viewport, const FrameTime& time);
+    
+    // Draw calls and quads of the last render()
+    const SpriteBatch& getSpriteBatch() const { return m_spriteBatch; }
+    
+    // The renderer was recreated (SDL_RENDER_DEVICE_RESET); drops textures
+    // owned here so they are made again on the next render()
+    void releaseRenderTextures();
+    
+    // Active enemies, items, projectiles and explosions drawn and skipped as
+    // off-screen by the last render() (dead ones awaiting cleanup count as neither)
+    int getRenderedCount() const { return m_renderedCount; }
+    int getCulledCount() const { return m_culledCount; }
     
     // Handle collisions between all entities
-    void handleCollisions(Uint32 currentTime);
+    void handleCollisions();
     
     // Getters
     Player& getPlayer() { return m_player; }
     Pet& getPet() { return m_pet; }
-    const std::vector<Enemy>& getEnemies() const { return m_enemies; }
-    const std::vector<Item>& getItems() const { return m_items; }
+    const EnemyStore& getEnemies() const { return m_enemies; }
+    const ItemStore& getItems() const { return m_items; }
     
     // Game state
     int getScore() const { return m_player.getScore(); }
     
+    // Print high-water mark and capacity of every object pool (and the item store)
+    void logPoolUsage() const;
+    
     // Reset game
     void reset();
     
@@ -43,43 +120,116 @@ private:
     // Game entities
     Player m_player;
     Pet m_pet;
-    std::vector<Enemy> m_enemies;
-    std::vector<Item> m_items;
+    ProjectileSystem m_projectiles;
+    EnemyStore m_enemies;
+    ItemStore m_items;
+    std::vector<int> m_itemHits;
+    
+    // Merges nearby shards so at most Item::MAX_SHARDS lie on the ground
+    ShardCoalescer m_shardCoalescer;
+    static constexpr int SHARD_MERGE_CELL_SIZE = 32;
+    
+    // Spatial partitioning for enemy separation (rebuilt every tick)
+    SpatialGrid m_enemyGrid;
+    
+    // Broadphase for combat queries against enemies (refreshed once per tick
+    // after enemies move and spawn)
+    CollisionWorld m_collisionWorld;
+    std::vector<int> m_collisionHits;
+    static constexpr int COLLISION_CELL_SIZE = 64;
+    
+    // Hits detected this tick, applied together after the last combat pass
+    CombatBuffer m_combat;
+    
+    // Parallel enemy step, with one set of query buffers and LOD counters per job thread
+    struct EnemyStepScratch {
+        std::vector<int> nearbyEnemies;
+        SeparationCandidates separationCandidates;
+        LodBandStats lodStats[SimulationLod::MAX_BANDS];
+    };
+    JobSystem m_inlineJobs; // Not started: runs jobs on the calling thread
+    JobSystem* m_jobs = &m_inlineJobs;
+    std::vector<EnemyStepScratch> m_enemyStepScratch;
+    static constexpr size_t ENEMY_CHUNK_SIZE = 64;
+    SimulationLod m_simulationLod;
+    
+    // Pursuit headings toward the player, re-targeted when the player changes tile
+    FlowField m_flowField;
+    static constexpr int DEFAULT_TILE_SIZE = 16;
+    int m_tileWidth = DEFAULT_TILE_SIZE;
+    int m_tileHeight = DEFAULT_TILE_SIZE;
+    static constexpr int FLOW_FIELD_RADIUS_TILES = 64; // Reaches past the first two LOD bands at 16px tiles
+    
+    // Randomness: independent streams so e.g. extra drops don't shift spawn layouts
+    uint64_t m_seed;
+    Random m_spawnRandom;
+    Random m_dropRandom;
+    void reseedStreams();
+    
+    // Load profile and the buffer sizes derived from it
+    Scenario m_scenario;
+    void reserveEnemyCapacity();
     
     // Game state
     Uint32 m_lastEnemySpawn;
     Uint32 m_magnetEffectEndTime;
     
-    // Explosion effects
+    // Entity sprites and rects are queued here and drawn in a few batches
+    SpriteBatch m_spriteBatch;
+    TextLabel m_levelLabels[Enemy::MAX_ENEMY_LEVEL]; // Level numbers, formatted once
+    
+    // Render culling. Enemies are found through the collision world's cells,
+    // which index them as of the end of the last tick's spawn phase; cleanup
+    // records where each of those indices moved to.
+    std::vector<int> m_enemyRemap;
+    std::vector<int> m_visibleEnemies;
+    std::vector<int> m_visibleItems;
+    int m_renderedCount = 0;
+    int m_culledCount = 0;
+    static constexpr int RENDER_CULL_MARGIN = 64; // Well beyond anything's movement in one tick
+    void collectVisibleEnemies(const SDL_Rect& viewport, const FrameTime& time);
+    void collectVisibleItems(const SDL_Rect& viewport, const FrameTime& time);
+    
+    // Explosion effects, kept dense: new ones are refused once MAX_EXPLOSIONS
+    // are live, and a finished one's slot is refilled from the end
     struct Explosion {
         int x, y;
         float radius;
         Uint32 startTime;
         Uint32 duration;
-        bool active;
     };
     std::vector<Explosion> m_explosions;
+    static constexpr int MAX_EXPLOSIONS = 32;
+    int m_explosionHighWater = 0;
+    int m_failedExplosions = 0;
+    ExplosionRenderer m_explosionRenderer;
+    std::vector<SDL_Point> m_explosionCenters; // On-screen explosions of the frame, for the outline pass
+    std::vector<float> m_explosionRadii;
     
     // World bounds
     int m_worldWidth;
     int m_worldHeight;
     
+    // Profiling
+    bool m_profilingEnabled = false;
+    Uint64 m_phaseCounters[static_cast<int>(UpdatePhase::COUNT)] = {};
+    void endPhase(UpdatePhase phase, Uint64& phaseStart);
+    
     // Helper methods
-    void spawnEnemies(Uint32 currentTime);
-    void updateEnemies(Uint32 currentTime);
-    void updateItems(Uint32 currentTime);
+    void spawnEnemies(const FrameTime& time);
+    void updateEnemies(const FrameTime& time);
+    void rebuildEnemyGrid();
+    void updateItems(const FrameTime& time);
     void cleanupInactiveEntities();
     
     // Collision handling
-    void handlePlayerAttackCollisions(Uint32 currentTime);
+    void handlePlayerAttackCollisions();
     void handlePlayerEnemyCollisions();
-    void handleProjectileCollisions(Uint32 currentTime);
+    void handleProjectileCollisions(const FrameTime& time);
     void handleExplosionDamage(int explosionX, int explosionY, float explosionRadius);
     
     // Explosion rendering
-    void renderExplosions(SDL_Renderer* renderer, int cameraOffsetX, int cameraOffsetY);
+    int renderExplosions(SDL_Renderer* renderer, const SDL_Rect& viewport, const FrameTime& time);
     void updateExplosions(Uint32 currentTime);
     
-    // Projectile timer rendering
-    void renderProjectileTimers(SDL_Renderer* renderer, AssetManager* assetManager, int cameraOffsetX, int cameraOffsetY);
 };
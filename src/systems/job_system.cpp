@@ -0,0 +1,241 @@
+#include "job_system.h"
+#include <algorithm>
+
+namespace {
+
+// Which system and queue the current thread belongs to (workers only; any
+// other thread is treated as the owning thread, index 0)
+thread_local const JobSystem* t_jobSystem = nullptr;
+thread_local int t_threadIndex = 0;
+    
+} // namespace
+
+JobSystem::JobSystem() : m_running(false), m_stopping(false), m_waitingThreads(0) {
+    // Usable before start(): everything runs on the calling thread
+    m_queues.push_back(new Queue());
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+    for (Queue* queue : m_queues) {
+        delete queue;
+    }
+}
+
+int JobSystem::resolveThreadCount(int requested) {
+#ifdef __EMSCRIPTEN__
+    // The web build is compiled without pthreads
+    (void)requested;
+    return 1;
+#else
+    if (requested > 0) return requested;
+    
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, hardwareThreads);
+#endif
+}
+
+void JobSystem::start(int threadCount) {
+    shutdown();
+    
+    int total = resolveThreadCount(threadCount);
+    for (Queue* queue : m_queues) {
+        delete queue;
+    }
+    m_queues.clear();
+    for (int i = 0; i < total; i++) {
+        m_queues.push_back(new Queue());
+    }
+    
+    m_stopping = false;
+    m_running = true;
+    
+    // Thread 0 is the caller
+    for (int i = 1; i < total; i++) {
+        m_threads.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+void JobSystem::shutdown() {
+    if (!m_running) return;
+    
+    // Drain what the owning thread still has queued, then let the workers
+    // finish theirs and exit
+    while (tryRunOne(0)) {
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+    m_running = false;
+}
+
+void JobSystem::run(std::function<void(int threadIndex)> job, JobCounter& counter) {
+    counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+    push(getThreadIndex(), {std::move(job), &counter});
+}
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void(int threadIndex)> job, JobCounter& counter) {
+    // Counts as outstanding from now, so waiting on counter covers the dependency too
+    counter.m_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(dependency.m_mutex);
+        if (dependency.m_pending.load(std::memory_order_acquire) > 0) {
+            dependency.m_continuations.push_back({std::move(job), &counter});
+            return;
+        }
+    }
+    push(getThreadIndex(), {std::move(job), &counter});
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    int threadIndex = getThreadIndex();
+    while (!counter.isDone()) {
+        if (tryRunOne(threadIndex)) continue;
+        
+        // Everything left is running elsewhere; finish() and push() wake us
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_waitingThreads++;
+        m_waitCondition.wait(lock, [this, &counter] { return counter.isDone() || m_queuedJobs.load() > 0; });
+        m_waitingThreads--;
+    }
+    
+    // The last job may still be inside finish(); don't let the caller reuse
+    // or destroy the counter until it has let go
+    std::lock_guard<std::mutex> lock(counter.m_mutex);
+}
+
+void JobSystem::parallelFor(size_t count, size_t minChunkSize,
+                            const std::function<void(size_t begin, size_t end, int threadIndex)>& job) {
+    if (count == 0) return;
+    
+    minChunkSize = std::max<size_t>(1, minChunkSize);
+    
+    // Too little work to be worth waking anyone - run it inline
+    size_t threadCount = m_queues.size();
+    if (threadCount == 1 || count <= minChunkSize) {
+        job(0, count, getThreadIndex());
+        return;
+    }
+    
+    // A few chunks per thread so uneven chunks still balance out
+    size_t chunkCount = std::min((count + minChunkSize - 1) / minChunkSize, threadCount * 4);
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    
+    JobCounter counter;
+    for (size_t begin = 0; begin < count; begin += chunkSize) {
+        size_t end = std::min(begin + chunkSize, count);
+        run([&job, begin, end](int threadIndex) { job(begin, end, threadIndex); }, counter);
+    }
+    wait(counter);
+}
+
+void JobSystem::workerLoop(int threadIndex) {
+    t_jobSystem = this;
+    t_threadIndex = threadIndex;
+    
+    while (true) {
+        if (tryRunOne(threadIndex)) continue;
+        
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [this] { return m_stopping || m_queuedJobs.load() > 0; });
+        if (m_stopping && m_queuedJobs.load() == 0) break;
+    }
+    
+    t_jobSystem = nullptr;
+    t_threadIndex = 0;
+}
+
+int JobSystem::getThreadIndex() const {
+    return t_jobSystem == this ? t_threadIndex : 0;
+}
+
+void JobSystem::push(int threadIndex, Job job) {
+    {
+        Queue& queue = *m_queues[threadIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    
+    // Taking the wake mutex orders this against a worker checking the count
+    // and going to sleep, so the notification can't be lost
+    bool wakeWaiters;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_queuedJobs.fetch_add(1);
+        wakeWaiters = m_waitingThreads > 0;
+    }
+    m_wakeCondition.notify_one();
+    if (wakeWaiters) m_waitCondition.notify_all();
+}
+
+bool JobSystem::tryRunOne(int threadIndex) {
+    Job job;
+    bool found = false;
+    
+    // Own queue first, newest job
+    {
+        Queue& queue = *m_queues[threadIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            found = true;
+        }
+    }
+    
+    // Otherwise steal the oldest job from another thread
+    int queueCount = static_cast<int>(m_queues.size());
+    for (int offset = 1; !found && offset < queueCount; offset++) {
+        Queue& queue = *m_queues[(threadIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            found = true;
+            m_stolenCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    if (!found) return false;
+    
+    m_queuedJobs.fetch_sub(1);
+    execute(job, threadIndex);
+    return true;
+}
+
+void JobSystem::execute(Job& job, int threadIndex) {
+    job.function(threadIndex);
+    m_executedCount.fetch_add(1, std::memory_order_relaxed);
+    finish(*job.counter, threadIndex);
+}
+
+void JobSystem::finish(JobCounter& counter, int threadIndex) {
+    // Continuations are taken under the lock so a concurrent runAfter() either
+    // sees the counter still pending or queues its job directly
+    std::vector<JobCounter::Continuation> continuations;
+    {
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+        if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        continuations.swap(counter.m_continuations);
+    }
+    
+    // Wake anyone sleeping in wait(); as in push(), the mutex keeps a thread
+    // that is about to sleep from missing this
+    bool wakeWaiters;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        wakeWaiters = m_waitingThreads > 0;
+    }
+    if (wakeWaiters) m_waitCondition.notify_all();
+    
+    for (auto& continuation : continuations) {
+        push(threadIndex, {std::move(continuation.job), continuation.counter});
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+// Counts outstanding jobs. A counter reaches zero when every job submitted
+// against it has finished; continuations registered with
+// JobSystem::runAfter() are scheduled at that point. Counters can be reused
+// once they reach zero, and must outlive the jobs and continuations that
+// reference them.
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+    
+    bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    
+    struct Continuation {
+        std::function<void(int)> job;
+        JobCounter* counter;
+    };
+    
+    std::atomic<int> m_pending{0};
+    std::mutex m_mutex; // Guards m_continuations
+    std::vector<Continuation> m_continuations;
+};
+
+// Work-stealing job scheduler shared by the engine's systems.
+// Every thread that runs jobs owns a deque: it pushes and pops its own work
+// at the back (newest first, cache-warm) while idle threads steal from the
+// front of other deques. Thread 0 is the thread that started the system;
+// wait() makes it help run jobs, and sleep only once everything left is
+// running elsewhere, so with no worker threads (e.g. the web build)
+// everything still runs, just inline.
+//
+// Jobs get the index of the thread running them (0..getThreadCount()-1), so
+// callers can keep per-thread scratch without locking - as long as the job
+// doesn't wait(), since a waiting thread may pick up another job with the
+// same index. Submit and wait from the owning thread or from inside jobs.
+class JobSystem {
+public:
+    JobSystem();
+    ~JobSystem();
+    
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    
+    // Start the worker threads; threadCount includes the calling thread and
+    // 0 picks one per hardware thread. Restarts the system if it is running.
+    void start(int threadCount = 0);
+    
+    // Finish all queued jobs and join the workers. Safe to call twice; start()
+    // can bring the system back up afterwards.
+    void shutdown();
+    bool isRunning() const { return m_running; }
+    
+    // Queue job against counter
+    void run(std::function<void(int threadIndex)> job, JobCounter& counter);
+    
+    // Queue job against counter once dependency reaches zero (immediately if it already has)
+    void runAfter(JobCounter& dependency, std::function<void(int threadIndex)> job, JobCounter& counter);
+    
+    // Run queued jobs on this thread until counter reaches zero, sleeping
+    // while the rest of its jobs run on other threads
+    void wait(JobCounter& counter);
+    
+    // Run job(begin, end, threadIndex) over [0, count) in chunks of at least
+    // minChunkSize and return once every chunk is done
+    void parallelFor(size_t count, size_t minChunkSize,
+                     const std::function<void(size_t begin, size_t end, int threadIndex)>& job);
+    
+    // Number of threads that can run jobs (workers + the owning thread)
+    int getThreadCount() const { return static_cast<int>(m_queues.size()); }
+    
+    // Map a requested count (0 = auto) to what this platform can run
+    static int resolveThreadCount(int requested);
+    
+    // Counters
+    long long getExecutedCount() const { return m_executedCount.load(); }
+    long long getStolenCount() const { return m_stolenCount.load(); }
+
+private:
+    struct Job {
+        std::function<void(int)> function;
+        JobCounter* counter;
+    };
+    
+    // One per thread; the mutex is only contended when someone steals
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+    
+    std::vector<Queue*> m_queues;
+    std::vector<std::thread> m_threads;
+    bool m_running;
+    
+    // Sleeping workers wait here until work is queued or the system stops
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::atomic<int> m_queuedJobs{0};
+    bool m_stopping;
+    
+    // Threads in wait() sleep here until a counter reaches zero or work is
+    // queued (guarded by m_wakeMutex too)
+    std::condition_variable m_waitCondition;
+    int m_waitingThreads;
+    
+    std::atomic<long long> m_executedCount{0};
+    std::atomic<long long> m_stolenCount{0};
+    
+    // Helper methods
+    void workerLoop(int threadIndex);
+    int getThreadIndex() const;
+    void push(int threadIndex, Job job);
+    bool tryRunOne(int threadIndex);
+    void execute(Job& job, int threadIndex);
+    void finish(JobCounter& counter, int threadIndex);
+};
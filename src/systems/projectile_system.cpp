@@ -0,0 +1,297 @@
+#include "projectile_system.h"
+#include "collision_world.h"
+#include "combat_buffer.h"
+#include "../rendering/bitmap_font.h"
+#include "../rendering/sprite_batch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+// Indexed by ProjectileType
+const ProjectileTypeInfo PROJECTILE_TYPES[] = {
+    // owner                   size speed fuse  life  radius  decel  hits   stops  effect fuse text  color
+    {ProjectileOwner::PLAYER, 12,  3.0f, 3000, 0,    100.0f, true,  false, true,  true,  true,  {150, 50, 50, 255}},  // BOMB
+    {ProjectileOwner::PLAYER, 8,   8.0f, 0,    2000, 0.0f,   false, true,  false, false, false, {139, 69, 19, 255}},  // ARROW
+    {ProjectileOwner::PLAYER, 8,   6.0f, 2000, 0,    50.0f,  false, false, false, false, false, {255, 140, 0, 255}},  // FIREBALL
+    {ProjectileOwner::PLAYER, 8,   0.0f, 0,    200,  0.0f,   false, false, false, false, false, {192, 192, 192, 255}}, // SWORD_SLASH
+    {ProjectileOwner::PET,    4,   8.0f, 0,    2000, 0.0f,   false, true,  false, false, false, {255, 255, 0, 255}}   // PET_BOLT
+};
+
+const int TYPE_COUNT = static_cast<int>(ProjectileType::COUNT);
+static_assert(sizeof(PROJECTILE_TYPES) / sizeof(PROJECTILE_TYPES[0]) == static_cast<size_t>(ProjectileType::COUNT),
+              "every projectile type needs a table entry");
+    
+} // namespace
+
+ProjectileSystem::ProjectileSystem() : m_capacity(0), m_highWater(0), m_failedSpawns(0) {
+}
+
+ProjectileSystem::~ProjectileSystem() {
+    // Cleanup handled by vector destructors
+}
+
+const ProjectileTypeInfo& ProjectileSystem::getTypeInfo(ProjectileType type) {
+    return PROJECTILE_TYPES[static_cast<int>(type)];
+}
+
+void ProjectileSystem::initialize(int capacity) {
+    m_capacity = capacity;
+    m_x.reserve(capacity);
+    m_y.reserve(capacity);
+    m_dirX.reserve(capacity);
+    m_dirY.reserve(capacity);
+    m_type.reserve(capacity);
+    m_active.reserve(capacity);
+    m_stopped.reserve(capacity);
+    m_spawnTime.reserve(capacity);
+    m_prevX.reserve(capacity);
+    m_prevY.reserve(capacity);
+    m_retired.reserve(capacity);
+    m_detonations.reserve(16);
+    m_hitCandidates.reserve(16);
+    for (int type = 0; type < TYPE_COUNT; type++) {
+        m_renderRects[type].reserve(capacity);
+        m_renderIndices[type].reserve(capacity);
+    }
+    
+    clear();
+    m_highWater = 0;
+    m_failedSpawns = 0;
+}
+
+void ProjectileSystem::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_dirX.clear();
+    m_dirY.clear();
+    m_type.clear();
+    m_active.clear();
+    m_stopped.clear();
+    m_spawnTime.clear();
+    m_prevX.clear();
+    m_prevY.clear();
+    m_retired.clear();
+    m_detonations.clear();
+}
+
+void ProjectileSystem::clear(ProjectileOwner owner) {
+    for (int i = 0; i < size(); i++) {
+        if (m_active[i] && PROJECTILE_TYPES[m_type[i]].owner == owner) {
+            retire(i);
+        }
+    }
+    removeInactive();
+}
+
+int ProjectileSystem::spawn(ProjectileType type, int x, int y, float dirX, float dirY, Uint32 spawnTime) {
+    if (size() >= m_capacity) {
+        m_failedSpawns++;
+        return -1;
+    }
+    
+    m_x.push_back(static_cast<float>(x));
+    m_y.push_back(static_cast<float>(y));
+    m_dirX.push_back(dirX);
+    m_dirY.push_back(dirY);
+    m_type.push_back(static_cast<Uint8>(type));
+    m_active.push_back(1);
+    m_stopped.push_back(0);
+    m_spawnTime.push_back(spawnTime);
+    m_prevX.push_back(static_cast<float>(x));
+    m_prevY.push_back(static_cast<float>(y));
+    
+    m_highWater = std::max(m_highWater, size());
+    return size() - 1;
+}
+
+void ProjectileSystem::snapshotPositions() {
+    m_prevX.assign(m_x.begin(), m_x.end());
+    m_prevY.assign(m_y.begin(), m_y.end());
+}
+
+void ProjectileSystem::update(const FrameTime& time) {
+    m_detonations.clear();
+    
+    int count = size();
+    for (int i = 0; i < count; i++) {
+        if (!m_active[i]) continue;
+        
+        const ProjectileTypeInfo& info = PROJECTILE_TYPES[m_type[i]];
+        Uint32 age = time.simTime - m_spawnTime[i];
+        if (info.lifetime > 0 && age > info.lifetime) {
+            retire(i);
+            continue;
+        }
+        
+        // Move along the launch direction; bombs slow to a stop as the fuse runs out
+        if (!m_stopped[i] && info.speed > 0) {
+            float speed = info.speed;
+            if (info.decelerates) {
+                speed *= 1.0f - static_cast<float>(age) / info.fuse;
+                if (speed < 0.1f) speed = 0.0f;
+            }
+            m_x[i] += m_dirX[i] * speed * time.stepScale;
+            m_y[i] += m_dirY[i] * speed * time.stepScale;
+        }
+        
+        if (info.fuse > 0 && age >= info.fuse) {
+            m_detonations.push_back({getX(i), getY(i), info.explosionRadius, info.explosionEffect});
+            retire(i);
+        }
+    }
+}
+
+void ProjectileSystem::handleEnemyHits(const CollisionWorld& collisionWorld, const EnemyStore& enemies,
+                                       CombatBuffer& combat) {
+    int count = size();
+    for (int i = 0; i < count; i++) {
+        if (!m_active[i]) continue;
+        
+        const ProjectileTypeInfo& info = PROJECTILE_TYPES[m_type[i]];
+        if (!info.hitsEnemies && !(info.stopsOnEnemies && !m_stopped[i])) continue;
+        
+        // Hits come back in enemy index order, so the projectile strikes the first one
+        SDL_Rect rect = getRect(i);
+        collisionWorld.queryRect(rect, m_hitCandidates);
+        combat.filterRect(enemies, rect, m_hitCandidates);
+        if (m_hitCandidates.empty()) continue;
+        
+        if (info.stopsOnEnemies) {
+            // Stop moving but keep the fuse running
+            m_stopped[i] = 1;
+            std::cout << "Bomb hit enemy and stopped at (" << getX(i) << ", " << getY(i) << ") - waiting for timer" << std::endl;
+            continue;
+        }
+        
+        // Damage the enemy and knock it back along the line from the projectile
+        int enemy = m_hitCandidates.front();
+        float dx = enemies.getX(static_cast<size_t>(enemy)) - m_x[i];
+        float dy = enemies.getY(static_cast<size_t>(enemy)) - m_y[i];
+        float distance = std::sqrt(dx * dx + dy * dy);
+        combat.addHit(enemy, dx, dy, distance, HitSource::PROJECTILE);
+        
+        retire(i);
+    }
+}
+
+int ProjectileSystem::getActiveCount() const {
+    int count = 0;
+    for (Uint8 active : m_active) {
+        count += active;
+    }
+    return count;
+}
+
+void ProjectileSystem::retire(int i) {
+    m_active[i] = 0;
+    m_retired.push_back(i);
+}
+
+void ProjectileSystem::removeInactive() {
+    if (m_retired.empty()) return;
+    
+    // Highest index first: everything above the one being removed is then
+    // live, so the last projectile can be moved into its slot
+    std::sort(m_retired.begin(), m_retired.end(), [](int a, int b) { return a > b; });
+    for (int i : m_retired) {
+        int last = size() - 1;
+        if (i != last) {
+            m_x[i] = m_x[last];
+            m_y[i] = m_y[last];
+            m_dirX[i] = m_dirX[last];
+            m_dirY[i] = m_dirY[last];
+            m_type[i] = m_type[last];
+            m_active[i] = m_active[last];
+            m_stopped[i] = m_stopped[last];
+            m_spawnTime[i] = m_spawnTime[last];
+            m_prevX[i] = m_prevX[last];
+            m_prevY[i] = m_prevY[last];
+        }
+        m_x.pop_back();
+        m_y.pop_back();
+        m_dirX.pop_back();
+        m_dirY.pop_back();
+        m_type.pop_back();
+        m_active.pop_back();
+        m_stopped.pop_back();
+        m_spawnTime.pop_back();
+        m_prevX.pop_back();
+        m_prevY.pop_back();
+    }
+    m_retired.clear();
+}
+
+SDL_Rect ProjectileSystem::getRect(int i) const {
+    int size = PROJECTILE_TYPES[m_type[i]].size;
+    return {getX(i), getY(i), size, size};
+}
+
+int ProjectileSystem::render(SpriteBatch& batch, const SDL_Rect& viewport, const FrameTime& time,
+                            BitmapFont* font) const {
+    for (int type = 0; type < TYPE_COUNT; type++) {
+        m_renderRects[type].clear();
+        m_renderIndices[type].clear();
+    }
+    
+    // Bucket interpolated rects of on-screen projectiles by type
+    int drawn = 0;
+    int count = size();
+    for (int i = 0; i < count; i++) {
+        if (!m_active[i]) continue;
+        
+        int size = PROJECTILE_TYPES[m_type[i]].size;
+        int x = static_cast<int>(m_prevX[i] + (m_x[i] - m_prevX[i]) * time.alpha);
+        int y = static_cast<int>(m_prevY[i] + (m_y[i] - m_prevY[i]) * time.alpha);
+        SDL_Rect bounds = {x - CULL_MARGIN, y - CULL_MARGIN, size + 2 * CULL_MARGIN, size + 2 * CULL_MARGIN};
+        if (!SDL_HasIntersection(&bounds, &viewport)) continue;
+        
+        m_renderRects[m_type[i]].push_back({x - viewport.x, y - viewport.y, size, size});
+        m_renderIndices[m_type[i]].push_back(i);
+        drawn++;
+    }
+    
+    // Type by type (solid quads, so they all share one batch)
+    for (int type = 0; type < TYPE_COUNT; type++) {
+        for (const SDL_Rect& rect : m_renderRects[type]) {
+            batch.fillRect(rect, PROJECTILE_TYPES[type].color);
+        }
+    }
+    
+    // Fuse countdowns
+    for (int type = 0; type < TYPE_COUNT; type++) {
+        if (!PROJECTILE_TYPES[type].showsFuse) continue;
+        
+        for (size_t k = 0; k < m_renderIndices[type].size(); k++) {
+            int i = m_renderIndices[type][k];
+            Uint32 fuseEnd = m_spawnTime[i] + PROJECTILE_TYPES[type].fuse;
+            Uint32 remaining = time.simTime >= fuseEnd ? 0 :
+                               std::min(fuseEnd - time.simTime, PROJECTILE_TYPES[type].fuse);
+            renderFuse(batch, m_renderRects[type][k], remaining, font);
+        }
+    }
+    return drawn;
+}
+
+void ProjectileSystem::renderFuse(SpriteBatch& batch, const SDL_Rect& rect, Uint32 remaining, BitmapFont* font) const {
+    // Position above the projectile
+    int timerX = rect.x + rect.w / 2;
+    int timerY = rect.y - 20;
+    
+    // Draw a background rectangle for the timer
+    SDL_Rect timerBg = {timerX - 15, timerY - 8, 30, 16};
+    batch.fillRect(timerBg, {0, 0, 0, 180}); // Semi-transparent black
+    
+    // Draw timer border
+    batch.drawRect(timerBg, {255, 255, 255, 255});
+    
+    if (!font) return;
+    
+    // Seconds left, e.g. "2.4"
+    char timerText[16];
+    std::snprintf(timerText, sizeof(timerText), "%.1f", remaining / 1000.0f);
+    SDL_Color textColor = {255, 255, 255, 255};
+    font->renderText(batch, timerText, timerX - 10, timerY - 5, textColor);
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+#include "frame_clock.h"
+#include "../entities/enemy_store.h"
+
+// Forward declarations
+class CollisionWorld;
+class CombatBuffer;
+class BitmapFont;
+class SpriteBatch;
+
+enum class ProjectileType {
+    BOMB,
+    ARROW,
+    FIREBALL,
+    SWORD_SLASH,
+    PET_BOLT,
+    COUNT
+};
+
+enum class ProjectileOwner {
+    PLAYER,
+    PET
+};
+
+// Tuning for one projectile type
+struct ProjectileTypeInfo {
+    ProjectileOwner owner;
+    int size;
+    float speed;           // Pixels per 60 Hz tick
+    Uint32 fuse;           // Milliseconds until it detonates (0 = never)
+    Uint32 lifetime;       // Milliseconds until it disappears without detonating (0 = never)
+    float explosionRadius; // Damage radius when it detonates
+    bool decelerates;      // Slows linearly to a stop when the fuse runs out
+    bool hitsEnemies;      // Damages the first enemy it touches, then disappears
+    bool stopsOnEnemies;   // Stops moving when it touches an enemy (the fuse keeps running)
+    bool explosionEffect;  // Detonation leaves a visible explosion
+    bool showsFuse;        // Countdown drawn above it
+    SDL_Color color;
+};
+
+// A projectile whose fuse ran out this tick
+struct Detonation {
+    int x, y;
+    float radius;
+    bool effect;
+};
+
+// Every projectile in the game - player bombs, arrows, fireballs and sword
+// slashes, and the pet's bolts - in one structure-of-arrays store. Behaviour
+// comes from a per-type table rather than per-type code, so a tick is one
+// update loop, one hit loop and one batched draw however many there are.
+class ProjectileSystem {
+public:
+    ProjectileSystem();
+    ~ProjectileSystem();
+    
+    static constexpr int MAX_PROJECTILES = 1024; // Launches are dropped while the store is full
+    static const ProjectileTypeInfo& getTypeInfo(ProjectileType type);
+    
+    // Allocate storage for capacity projectiles (drops any live ones)
+    void initialize(int capacity);
+    void clear();
+    void clear(ProjectileOwner owner);
+    int size() const { return static_cast<int>(m_x.size()); }
+    int getActiveCount() const;
+    
+    // Launch a projectile with its top-left corner at (x, y) along a unit
+    // direction. Returns its index, or -1 if the store is full.
+    int spawn(ProjectileType type, int x, int y, float dirX, float dirY, Uint32 spawnTime);
+    
+    // Copy current positions into the previous-tick buffer (for render interpolation)
+    void snapshotPositions();
+    
+    // Move every projectile, retire expired ones and detonate the ones whose
+    // fuse ran out (listed in getDetonations() until the next update)
+    void update(const FrameTime& time);
+    const std::vector<Detonation>& getDetonations() const { return m_detonations; }
+    
+    // Direct hits on enemies: records a hit for each projectile that strikes
+    // one and stops the ones that stop. Enemies are only read; collisionWorld
+    // must be fresh and combat holds the tick's earlier hits.
+    void handleEnemyHits(const CollisionWorld& collisionWorld, const EnemyStore& enemies, CombatBuffer& combat);
+    
+    // Remove the projectiles retired since the last call. Each one's slot is
+    // refilled from the end of the store, so the cost is per retired
+    // projectile (not per live one) and order is not launch order.
+    void removeInactive();
+    
+    // Draw the projectiles inside viewport (world coordinates), grouped by
+    // type, and their fuse countdowns. Returns how many were drawn.
+    int render(SpriteBatch& batch, const SDL_Rect& viewport, const FrameTime& time, BitmapFont* font) const;
+    
+    // Getters
+    ProjectileType getType(int i) const { return static_cast<ProjectileType>(m_type[i]); }
+    int getX(int i) const { return static_cast<int>(m_x[i]); }
+    int getY(int i) const { return static_cast<int>(m_y[i]); }
+    bool isActive(int i) const { return m_active[i] != 0; }
+    bool isStopped(int i) const { return m_stopped[i] != 0; }
+    Uint32 getSpawnTime(int i) const { return m_spawnTime[i]; }
+    SDL_Rect getRect(int i) const;
+    
+    // Counters
+    int getCapacity() const { return m_capacity; }
+    int getHighWater() const { return m_highWater; }
+    int getFailedSpawns() const { return m_failedSpawns; }
+
+private:
+    // Hot data
+    std::vector<float> m_x, m_y;
+    std::vector<float> m_dirX, m_dirY;
+    std::vector<Uint8> m_type;
+    std::vector<Uint8> m_active;
+    std::vector<Uint8> m_stopped;
+    std::vector<Uint32> m_spawnTime;
+    
+    // Positions at the start of the tick, for render interpolation
+    std::vector<float> m_prevX, m_prevY;
+    
+    int m_capacity;
+    int m_highWater;
+    int m_failedSpawns;
+    
+    std::vector<int> m_retired; // Deactivated since the last removeInactive()
+    
+    std::vector<Detonation> m_detonations;
+    std::vector<int> m_hitCandidates;
+    
+    // Scratch for batched drawing, one list of screen rects (and the
+    // projectiles they belong to) per type
+    mutable std::vector<SDL_Rect> m_renderRects[static_cast<int>(ProjectileType::COUNT)];
+    mutable std::vector<int> m_renderIndices[static_cast<int>(ProjectileType::COUNT)];
+    static constexpr int CULL_MARGIN = 32; // Fuse countdowns reach 28px above their bomb
+    
+    // Deactivate a live projectile and queue it for removeInactive()
+    void retire(int i);
+    
+    void renderFuse(SpriteBatch& batch, const SDL_Rect& rect, Uint32 remaining, BitmapFont* font) const;
+};
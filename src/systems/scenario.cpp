@@ -0,0 +1,143 @@
+#include "scenario.h"
+#include "../entities/enemy.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+Scenario::Scenario() {
+    // Stock game tuning
+    m_name = "default";
+    m_maxEnemies = DEFAULT_MAX_ENEMIES;
+    m_spawnInterval = DEFAULT_SPAWN_INTERVAL;
+    m_spawnBurst = 1;
+    m_spawnAreaWidth = 800;
+    m_spawnAreaHeight = 600;
+    m_spawnDistance = 100;
+    m_levelStart = 1;
+    m_scorePerLevel = 10;
+    m_levelMax = Enemy::MAX_ENEMY_LEVEL;
+    m_characterClass = CharacterClass::SWORDSMAN;
+    m_input = ScriptedInput::SQUARE;
+    m_turnInterval = 2;
+    m_attacksPerSecond = 2;
+    m_duration = 0;
+}
+
+Scenario::~Scenario() {
+}
+
+bool Scenario::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    
+    if (!file.is_open()) {
+        std::cout << "Scenario file " << filename << " not found, using defaults" << std::endl;
+        return false;
+    }
+    
+    std::string line;
+    while (std::getline(file, line)) {
+        // Remove comments and empty lines
+        size_t commentPos = line.find('#');
+        if (commentPos != std::string::npos) {
+            line = line.substr(0, commentPos);
+        }
+        line = trim(line);
+        
+        if (line.empty()) continue;
+        
+        // Parse key=value pairs
+        size_t equalsPos = line.find('=');
+        if (equalsPos == std::string::npos) continue;
+        
+        std::string key = trim(line.substr(0, equalsPos));
+        std::string value = trim(line.substr(equalsPos + 1));
+        
+        if (key == "name") {
+            m_name = value;
+        } else if (key == "max_enemies") {
+            m_maxEnemies = std::max(1, std::min(MAX_ENEMIES_LIMIT, parseInt(value, DEFAULT_MAX_ENEMIES)));
+        } else if (key == "spawn_interval_ms") {
+            m_spawnInterval = std::max(0, parseInt(value, DEFAULT_SPAWN_INTERVAL));
+        } else if (key == "spawn_burst") {
+            m_spawnBurst = std::max(1, parseInt(value, 1));
+        } else if (key == "spawn_area_width") {
+            m_spawnAreaWidth = std::max(1, parseInt(value, 800));
+        } else if (key == "spawn_area_height") {
+            m_spawnAreaHeight = std::max(1, parseInt(value, 600));
+        } else if (key == "spawn_distance") {
+            m_spawnDistance = std::max(0, parseInt(value, 100));
+        } else if (key == "level_start") {
+            m_levelStart = std::max(1, std::min(Enemy::MAX_ENEMY_LEVEL, parseInt(value, 1)));
+        } else if (key == "score_per_level") {
+            m_scorePerLevel = std::max(1, parseInt(value, 10));
+        } else if (key == "level_max") {
+            m_levelMax = std::max(1, std::min(Enemy::MAX_ENEMY_LEVEL, parseInt(value, Enemy::MAX_ENEMY_LEVEL)));
+        } else if (key == "character_class") {
+            if (!parseCharacterClass(value, m_characterClass)) {
+                std::cerr << "Unknown character class in scenario: " << value << std::endl;
+            }
+        } else if (key == "input") {
+            if (value == "square") {
+                m_input = ScriptedInput::SQUARE;
+            } else if (value == "idle") {
+                m_input = ScriptedInput::IDLE;
+            } else {
+                std::cerr << "Unknown input pattern in scenario: " << value << std::endl;
+            }
+        } else if (key == "turn_interval_seconds") {
+            m_turnInterval = std::max(1, parseInt(value, 2));
+        } else if (key == "attacks_per_second") {
+            m_attacksPerSecond = std::max(0, parseInt(value, 2));
+        } else if (key == "duration_seconds") {
+            m_duration = std::max(0, parseInt(value, 0));
+        } else {
+            std::cerr << "Unknown scenario key: " << key << std::endl;
+        }
+    }
+    
+    // A start level above the cap would never be reachable
+    m_levelMax = std::max(m_levelMax, m_levelStart);
+    
+    file.close();
+    std::cout << "Scenario '" << m_name << "' loaded from " << filename << ": up to " << m_maxEnemies
+              << " enemies, " << m_spawnBurst << " every " << m_spawnInterval << " ms" << std::endl;
+    return true;
+}
+
+bool Scenario::parseCharacterClass(const std::string& name, CharacterClass& characterClass) {
+    if (name == "swordsman") characterClass = CharacterClass::SWORDSMAN;
+    else if (name == "bomber") characterClass = CharacterClass::BOMBER;
+    else if (name == "archer") characterClass = CharacterClass::ARCHER;
+    else if (name == "mage") characterClass = CharacterClass::MAGE;
+    else return false;
+    return true;
+}
+
+const char* Scenario::getCharacterClassName(CharacterClass characterClass) {
+    switch (characterClass) {
+        case CharacterClass::SWORDSMAN: return "swordsman";
+        case CharacterClass::BOMBER: return "bomber";
+        case CharacterClass::ARCHER: return "archer";
+        case CharacterClass::MAGE: return "mage";
+    }
+    return "unknown";
+}
+
+std::string Scenario::trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = str.find_last_not_of(" \t\r");
+    return str.substr(first, (last - first + 1));
+}
+
+int Scenario::parseInt(const std::string& value, int defaultValue) {
+    std::istringstream stream(value);
+    int result;
+    if (!(stream >> result)) {
+        return defaultValue;
+    }
+    return result;
+}
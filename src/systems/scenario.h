@@ -0,0 +1,76 @@
+#pragma once
+#include <string>
+#include "../entities/player.h"
+
+enum class ScriptedInput {
+    SQUARE, // Walk a square, turning every turn interval, attacking regularly
+    IDLE    // No input at all
+};
+
+// Load profile for a run: how many enemies, how fast they arrive, how strong
+// they get, and (for the headless runner) who plays, how, and for how long.
+// Read from a key=value file like Settings; missing keys keep the defaults,
+// which reproduce the game's stock tuning. Scenario files are inputs only and
+// are never written back.
+class Scenario {
+public:
+    Scenario();
+    ~Scenario();
+    
+    // Load scenario from file; returns false (keeping defaults) if it can't be read
+    bool loadFromFile(const std::string& filename = "scenario.txt");
+    
+    const std::string& getName() const { return m_name; }
+    
+    // Enemy load
+    int getMaxEnemies() const { return m_maxEnemies; }
+    int getSpawnInterval() const { return m_spawnInterval; } // Milliseconds between spawn bursts
+    int getSpawnBurst() const { return m_spawnBurst; }       // Enemies per burst
+    
+    // Spawn ring: just outside a spawnAreaWidth x spawnAreaHeight box around the player
+    int getSpawnAreaWidth() const { return m_spawnAreaWidth; }
+    int getSpawnAreaHeight() const { return m_spawnAreaHeight; }
+    int getSpawnDistance() const { return m_spawnDistance; }
+    
+    // Level curve: levelStart + score / scorePerLevel, capped at levelMax
+    int getLevelStart() const { return m_levelStart; }
+    int getScorePerLevel() const { return m_scorePerLevel; }
+    int getLevelMax() const { return m_levelMax; }
+    
+    // Headless runner
+    CharacterClass getCharacterClass() const { return m_characterClass; }
+    ScriptedInput getInput() const { return m_input; }
+    int getTurnInterval() const { return m_turnInterval; }         // Seconds per leg of the square
+    int getAttacksPerSecond() const { return m_attacksPerSecond; }
+    int getDuration() const { return m_duration; }                 // Seconds of simulated time (0 = not set)
+    
+    // Character class names as used in scenario files and on the command line
+    static bool parseCharacterClass(const std::string& name, CharacterClass& characterClass);
+    static const char* getCharacterClassName(CharacterClass characterClass);
+    
+    // Defaults
+    static constexpr int DEFAULT_MAX_ENEMIES = 500;
+    static constexpr int DEFAULT_SPAWN_INTERVAL = 50; // milliseconds
+    static constexpr int MAX_ENEMIES_LIMIT = 1000000;
+
+private:
+    std::string m_name;
+    int m_maxEnemies;
+    int m_spawnInterval;
+    int m_spawnBurst;
+    int m_spawnAreaWidth;
+    int m_spawnAreaHeight;
+    int m_spawnDistance;
+    int m_levelStart;
+    int m_scorePerLevel;
+    int m_levelMax;
+    CharacterClass m_characterClass;
+    ScriptedInput m_input;
+    int m_turnInterval;
+    int m_attacksPerSecond;
+    int m_duration;
+    
+    // Helper functions
+    std::string trim(const std::string& str);
+    int parseInt(const std::string& value, int defaultValue);
+};
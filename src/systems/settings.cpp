@@ -8,6 +8,9 @@
 Settings::Settings() {
     // Initialize with default values
     m_fullscreen = false;
+    m_workerThreads = 0;
+    m_tickRate = 60;
+    m_seed = 0;
     m_filename = "settings.txt";
 }
 
@@ -45,6 +48,15 @@ bool Settings::loadFromFile(const std::string& filename) {
             if (key == "fullscreen") {
                 m_fullscreen = parseBool(value);
                 std::cout << "Loaded fullscreen setting: " << (m_fullscreen ? "true" : "false") << std::endl;
+            } else if (key == "worker_threads") {
+                m_workerThreads = std::max(0, parseInt(value, 0));
+                std::cout << "Loaded worker_threads setting: " << m_workerThreads << std::endl;
+            } else if (key == "tick_rate") {
+                m_tickRate = std::max(10, std::min(240, parseInt(value, 60)));
+                std::cout << "Loaded tick_rate setting: " << m_tickRate << std::endl;
+            } else if (key == "seed") {
+                m_seed = static_cast<unsigned int>(std::max(0, parseInt(value, 0)));
+                std::cout << "Loaded seed setting: " << m_seed << std::endl;
             }
         }
     }
@@ -69,6 +81,12 @@ bool Settings::saveToFile(const std::string& filename) {
     file << "# This file is automatically generated" << std::endl;
     file << std::endl;
     file << "fullscreen=" << (m_fullscreen ? "true" : "false") << std::endl;
+    file << "# Enemy update threads (0 = auto, 1 = single-threaded)" << std::endl;
+    file << "worker_threads=" << m_workerThreads << std::endl;
+    file << "# Simulation ticks per second (rendering interpolates between ticks)" << std::endl;
+    file << "tick_rate=" << m_tickRate << std::endl;
+    file << "# Random seed for enemy spawns and drops (0 = different every launch)" << std::endl;
+    file << "seed=" << m_seed << std::endl;
     
     file.close();
     std::cout << "Settings saved to " << m_filename << std::endl;
@@ -77,6 +95,9 @@ bool Settings::saveToFile(const std::string& filename) {
 
 void Settings::resetToDefaults() {
     m_fullscreen = false;
+    m_workerThreads = 0;
+    m_tickRate = 60;
+    m_seed = 0;
     std::cout << "Settings reset to defaults" << std::endl;
 }
 
@@ -95,3 +116,12 @@ bool Settings::parseBool(const std::string& value) {
     
     return (lowerValue == "true" || lowerValue == "1" || lowerValue == "yes" || lowerValue == "on");
 }
+
+int Settings::parseInt(const std::string& value, int defaultValue) {
+    std::istringstream stream(value);
+    int result;
+    if (!(stream >> result)) {
+        return defaultValue;
+    }
+    return result;
+}
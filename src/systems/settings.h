@@ -16,14 +16,30 @@ public:
     bool isFullscreen() const { return m_fullscreen; }
     void setFullscreen(bool fullscreen) { m_fullscreen = fullscreen; }
     
+    // Enemy update threads: 0 = one per hardware thread, 1 = single-threaded
+    int getWorkerThreads() const { return m_workerThreads; }
+    void setWorkerThreads(int workerThreads) { m_workerThreads = workerThreads; }
+    
+    // Fixed simulation rate in ticks per second (e.g. 30 or 60)
+    int getTickRate() const { return m_tickRate; }
+    void setTickRate(int tickRate) { m_tickRate = tickRate; }
+    
+    // Gameplay random seed (0 = new seed each launch)
+    unsigned int getSeed() const { return m_seed; }
+    void setSeed(unsigned int seed) { m_seed = seed; }
+    
     // Reset to defaults
     void resetToDefaults();
     
 private:
     bool m_fullscreen = false;
+    int m_workerThreads = 0;
+    int m_tickRate = 60;
+    unsigned int m_seed = 0;
     std::string m_filename;
     
     // Helper functions
     std::string trim(const std::string& str);
     bool parseBool(const std::string& value);
+    int parseInt(const std::string& value, int defaultValue);
 };
@@ -0,0 +1,81 @@
+#include "shard_coalescer.h"
+#include "../entities/item.h"
+#include <algorithm>
+
+ShardCoalescer::ShardCoalescer() : m_cellSize(32), m_maxShards(Item::MAX_SHARDS), m_mergedCount(0) {
+}
+
+ShardCoalescer::~ShardCoalescer() {
+    // Cleanup handled by vector destructor
+}
+
+void ShardCoalescer::initialize(int cellSize, int maxShards) {
+    m_cellSize = std::max(1, cellSize);
+    m_maxShards = std::max(1, maxShards);
+    m_mergedCount = 0;
+    m_entries.reserve(Item::MAX_ITEMS);
+}
+
+int ShardCoalescer::coalesce(ItemStore& items) {
+    int merged = 0;
+    int cellSize = m_cellSize;
+    for (int pass = 0; pass < MAX_PASSES; pass++) {
+        int passMerged = mergeByCell(items, cellSize);
+        merged += passMerged;
+        
+        // Still over budget: try again with coarser cells
+        if (static_cast<int>(m_entries.size()) - passMerged <= m_maxShards) break;
+        cellSize *= 2;
+    }
+    
+    m_mergedCount += merged;
+    return merged;
+}
+
+int ShardCoalescer::mergeByCell(ItemStore& items, int cellSize) {
+    // Bucket active shards by cell (floor division, so negative positions work too)
+    m_entries.clear();
+    for (int i = 0; i < items.size(); i++) {
+        if (!items.isActive(i) || items.getType(i) != ItemType::SHARD) continue;
+        
+        int centerX = items.getCenterX(i);
+        int centerY = items.getCenterY(i);
+        long long cellX = centerX >= 0 ? centerX / cellSize : (centerX - cellSize + 1) / cellSize;
+        long long cellY = centerY >= 0 ? centerY / cellSize : (centerY - cellSize + 1) / cellSize;
+        m_entries.push_back({(cellY << 32) ^ (cellX & 0xFFFFFFFFll), i});
+    }
+    std::sort(m_entries.begin(), m_entries.end());
+    
+    // Fold each run of same-cell shards into its highest-value member
+    int merged = 0;
+    size_t runStart = 0;
+    while (runStart < m_entries.size()) {
+        size_t runEnd = runStart + 1;
+        while (runEnd < m_entries.size() && m_entries[runEnd].cellKey == m_entries[runStart].cellKey) {
+            runEnd++;
+        }
+        
+        if (runEnd - runStart > 1) {
+            int survivor = m_entries[runStart].item;
+            int total = 0;
+            for (size_t e = runStart; e < runEnd; e++) {
+                int value = items.getValue(m_entries[e].item);
+                total += value;
+                if (value > items.getValue(survivor)) {
+                    survivor = m_entries[e].item;
+                }
+            }
+            
+            for (size_t e = runStart; e < runEnd; e++) {
+                if (m_entries[e].item != survivor) {
+                    items.setActive(m_entries[e].item, false);
+                    merged++;
+                }
+            }
+            items.setValue(survivor, total);
+        }
+        runStart = runEnd;
+    }
+    
+    return merged;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "../entities/item_store.h"
+
+// Keeps the number of shards on the ground bounded.
+// Shards lying in the same grid cell are merged into one; if more than the
+// budget remain, the pass repeats with cells twice as large until they fit.
+// Each group's highest-value shard survives at its own position and absorbs
+// the others' value, so the total value on the ground never changes. Merged
+// shards are only deactivated; the caller removes them with the other
+// inactive items.
+class ShardCoalescer {
+public:
+    ShardCoalescer();
+    ~ShardCoalescer();
+    
+    // Cell size of the first pass and the shard budget
+    void initialize(int cellSize, int maxShards);
+    
+    // Merge shards in items; returns the number of shards merged away
+    int coalesce(ItemStore& items);
+    
+    // Counters
+    int getMergedCount() const { return m_mergedCount; }
+    void resetCounters() { m_mergedCount = 0; }
+
+private:
+    struct CellEntry {
+        long long cellKey;
+        int item; // Index in the store
+        
+        bool operator<(const CellEntry& other) const {
+            return cellKey != other.cellKey ? cellKey < other.cellKey : item < other.item;
+        }
+    };
+    
+    // One merge pass at the given cell size; returns the shards merged away
+    int mergeByCell(ItemStore& items, int cellSize);
+    
+    int m_cellSize;
+    int m_maxShards;
+    int m_mergedCount;
+    std::vector<CellEntry> m_entries;
+    
+    static constexpr int MAX_PASSES = 16;
+};
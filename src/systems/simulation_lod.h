@@ -0,0 +1,74 @@
+#pragma once
+#include <SDL.h>
+#include <vector>
+
+// One distance band of the enemy simulation LOD
+struct LodBand {
+    int maxDistance;  // Upper bound (pixels from the player's centre) of this band
+    int interval;     // Update every N ticks, with an N-tick step
+    bool separation;  // Run the neighbour query and separation push
+};
+
+// Counters for one band, accumulated over ticks
+struct LodBandStats {
+    Uint64 enemyTicks = 0;    // Enemies in the band, summed over ticks
+    Uint64 updates = 0;       // Enemy updates actually run
+    Uint64 updateCounter = 0; // Performance-counter ticks spent in them (profiling only)
+    
+    void add(const LodBandStats& other) {
+        enemyTicks += other.enemyTicks;
+        updates += other.updates;
+        updateCounter += other.updateCounter;
+    }
+};
+
+// Distance-based level of detail for the enemy step.
+// Enemies far from the player (and so off screen) are updated every few
+// ticks with a proportionally larger step and without separation; the band
+// nearest the player always gets the full per-tick update. Bands are sorted
+// by distance and the last one covers everything beyond the others.
+class SimulationLod {
+public:
+    SimulationLod();
+    ~SimulationLod();
+    
+    static constexpr int MAX_BANDS = 4;
+    
+    // Replace the bands (at most MAX_BANDS, sorted by maxDistance; the first
+    // is forced to full fidelity so enemies near the player are never skipped)
+    void setBands(const std::vector<LodBand>& bands);
+    
+    // Bands for a scenario whose spawn area (the box around the player that
+    // enemies spawn outside of, normally the viewport) is width x height:
+    // full fidelity to a margin past its corners, half rate out to twice
+    // that, quarter rate beyond. An 800x600 area gives the stock bands.
+    void setDefaultBands(int areaWidth, int areaHeight);
+    const std::vector<LodBand>& getBands() const { return m_bands; }
+    int getBandCount() const { return static_cast<int>(m_bands.size()); }
+    const LodBand& getBand(int band) const { return m_bands[band]; }
+    
+    // Disabled: every enemy is in band 0
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+    
+    // Band for an enemy at the given offset from the player
+    int classify(int dx, int dy) const;
+    
+    // Longest step any band takes, in ticks
+    int getMaxInterval() const { return m_maxInterval; }
+    
+    // Counters (merged from the enemy step's per-worker counters)
+    void addStats(int band, const LodBandStats& stats) { m_stats[band].add(stats); }
+    const LodBandStats& getStats(int band) const { return m_stats[band]; }
+    void resetStats();
+    
+    // Print each band's population, skipped updates and time spent
+    void logStats(Uint64 tickCount) const;
+
+private:
+    std::vector<LodBand> m_bands;
+    std::vector<long long> m_maxDistanceSquared;
+    int m_maxInterval;
+    bool m_enabled;
+    LodBandStats m_stats[MAX_BANDS];
+};
@@ -0,0 +1,101 @@
+#include "spatial_grid.h"
+#include <algorithm>
+
+SpatialGrid::SpatialGrid() : m_cellSize(1), m_bucketMask(0) {
+    m_bucketStart.assign(2, 0);
+}
+
+SpatialGrid::~SpatialGrid() {
+    // Cleanup handled by vector destructors
+}
+
+void SpatialGrid::initialize(int cellSize, int expectedEntries) {
+    m_cellSize = std::max(1, cellSize);
+    
+    // Power-of-two bucket table with roughly two buckets per entry
+    unsigned int bucketCount = 64;
+    while (bucketCount < static_cast<unsigned int>(expectedEntries) * 2) {
+        bucketCount <<= 1;
+    }
+    m_bucketMask = bucketCount - 1;
+    m_bucketStart.assign(bucketCount + 1, 0);
+    
+    m_entries.reserve(expectedEntries);
+    m_pending.reserve(expectedEntries);
+    clear();
+}
+
+void SpatialGrid::clear() {
+    m_pending.clear();
+    m_entries.clear();
+    std::fill(m_bucketStart.begin(), m_bucketStart.end(), 0);
+}
+
+void SpatialGrid::insert(int index, int x, int y) {
+    m_pending.push_back({index, cellCoord(x), cellCoord(y)});
+}
+
+void SpatialGrid::build() {
+    // Grow the bucket table if the population outgrew the initial estimate
+    unsigned int bucketCount = m_bucketMask + 1;
+    if (m_pending.size() > bucketCount) {
+        while (bucketCount < m_pending.size() * 2) {
+            bucketCount <<= 1;
+        }
+        m_bucketMask = bucketCount - 1;
+        m_bucketStart.assign(bucketCount + 1, 0);
+    }
+    
+    // Counting sort of pending entries by bucket
+    std::fill(m_bucketStart.begin(), m_bucketStart.end(), 0);
+    for (const Entry& entry : m_pending) {
+        m_bucketStart[hashCell(entry.cellX, entry.cellY) + 1]++;
+    }
+    for (size_t b = 1; b < m_bucketStart.size(); b++) {
+        m_bucketStart[b] += m_bucketStart[b - 1];
+    }
+    
+    m_entries.resize(m_pending.size());
+    m_bucketCursor.assign(m_bucketStart.begin(), m_bucketStart.end() - 1);
+    for (const Entry& entry : m_pending) {
+        m_entries[m_bucketCursor[hashCell(entry.cellX, entry.cellY)]++] = entry;
+    }
+    m_pending.clear();
+}
+
+void SpatialGrid::queryNeighbors(int x, int y, int radius, std::vector<int>& out) const {
+    queryArea(x - radius, y - radius, x + radius, y + radius, out);
+}
+
+void SpatialGrid::queryArea(int minX, int minY, int maxX, int maxY, std::vector<int>& out) const {
+    if (m_entries.empty()) return;
+    
+    int minCellX = cellCoord(minX);
+    int maxCellX = cellCoord(maxX);
+    int minCellY = cellCoord(minY);
+    int maxCellY = cellCoord(maxY);
+    
+    for (int cellY = minCellY; cellY <= maxCellY; cellY++) {
+        for (int cellX = minCellX; cellX <= maxCellX; cellX++) {
+            unsigned int bucket = hashCell(cellX, cellY);
+            int end = m_bucketStart[bucket + 1];
+            for (int e = m_bucketStart[bucket]; e < end; e++) {
+                // Buckets are shared between colliding cells - only take this cell's entries
+                const Entry& entry = m_entries[e];
+                if (entry.cellX == cellX && entry.cellY == cellY) {
+                    out.push_back(entry.index);
+                }
+            }
+        }
+    }
+}
+
+int SpatialGrid::cellCoord(int value) const {
+    // Floor division so negative coordinates map to their own cells
+    return (value >= 0) ? value / m_cellSize : -((-value + m_cellSize - 1) / m_cellSize);
+}
+
+unsigned int SpatialGrid::hashCell(int cellX, int cellY) const {
+    unsigned int h = static_cast<unsigned int>(cellX) * 73856093u ^ static_cast<unsigned int>(cellY) * 19349663u;
+    return h & m_bucketMask;
+}
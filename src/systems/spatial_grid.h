@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+
+// Uniform spatial hash grid.
+// Entries are bucketed by the cell containing their point; cells are hashed
+// into a fixed-size bucket table so memory use is independent of world size.
+// The grid is rebuilt from scratch (clear / insert / build) once per tick.
+class SpatialGrid {
+public:
+    SpatialGrid();
+    ~SpatialGrid();
+    
+    // Set cell size and size the bucket table for the expected entry count
+    void initialize(int cellSize, int expectedEntries);
+    
+    // Rebuild steps
+    void clear();
+    void insert(int index, int x, int y);
+    void build();
+    
+    // Collect indices of all entries in cells overlapping the square
+    // [x - radius, x + radius] x [y - radius, y + radius]
+    void queryNeighbors(int x, int y, int radius, std::vector<int>& out) const;
+    
+    // Collect indices of all entries in cells overlapping [minX, maxX] x [minY, maxY]
+    void queryArea(int minX, int minY, int maxX, int maxY, std::vector<int>& out) const;
+    
+    // Call visit(index) for every entry in one cell (for ring searches that
+    // walk cells outwards and want to stop early)
+    template <typename Visitor>
+    void forEachInCell(int cellX, int cellY, Visitor&& visit) const {
+        if (m_entries.empty()) return;
+        
+        unsigned int bucket = hashCell(cellX, cellY);
+        int end = m_bucketStart[bucket + 1];
+        for (int e = m_bucketStart[bucket]; e < end; e++) {
+            const Entry& entry = m_entries[e];
+            if (entry.cellX == cellX && entry.cellY == cellY) {
+                visit(entry.index);
+            }
+        }
+    }
+    
+    // Cell containing a world coordinate
+    int getCellCoord(int value) const { return cellCoord(value); }
+    
+    // Getters
+    int getCellSize() const { return m_cellSize; }
+    int getEntryCount() const { return static_cast<int>(m_entries.size()); }
+
+private:
+    struct Entry {
+        int index;
+        int cellX, cellY;
+    };
+    
+    int m_cellSize;
+    unsigned int m_bucketMask;
+    
+    // Entries sorted by bucket; bucket b spans [m_bucketStart[b], m_bucketStart[b + 1])
+    std::vector<int> m_bucketStart;
+    std::vector<Entry> m_entries;
+    
+    // Entries inserted since the last build, and scratch write cursors for build()
+    std::vector<Entry> m_pending;
+    std::vector<int> m_bucketCursor;
+    
+    // Helper methods
+    int cellCoord(int value) const;
+    unsigned int hashCell(int cellX, int cellY) const;
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+
+// Small, fast, seedable PRNG (PCG32: 64-bit LCG state, xorshift + rotate output).
+// Each Random is an independent generator, so systems own their own instead of
+// sharing global rand() state. Generators with the same seed but different
+// stream ids produce unrelated sequences; parallel code should derive one per
+// stable work id (chunk index, entity index) rather than per worker thread, so
+// results don't depend on how work was scheduled.
+class Random {
+public:
+    explicit Random(uint64_t seed = 1, uint64_t stream = 0) {
+        setSeed(seed, stream);
+    }
+    
+    void setSeed(uint64_t seed, uint64_t stream = 0) {
+        m_seed = seed;
+        m_stream = stream;
+        m_state = 0;
+        m_increment = (stream << 1) | 1u;
+        next();
+        m_state += seed;
+        next();
+    }
+    
+    uint64_t getSeed() const { return m_seed; }
+    
+    // Independent generator for a sub-system or work item
+    Random substream(uint64_t streamId) const {
+        return Random(m_seed, m_stream * 0x9E3779B97F4A7C15ull + streamId + 1);
+    }
+    
+    // Uniform 32-bit value
+    uint32_t next() {
+        uint64_t oldState = m_state;
+        m_state = oldState * 6364136223846793005ull + m_increment;
+        uint32_t xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+        uint32_t rotation = static_cast<uint32_t>(oldState >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+    
+    // Uniform integer in [0, bound) without modulo bias
+    int nextInt(int bound) {
+        if (bound <= 1) return 0;
+        
+        uint32_t range = static_cast<uint32_t>(bound);
+        uint32_t threshold = (0u - range) % range;
+        while (true) {
+            uint32_t value = next();
+            if (value >= threshold) return static_cast<int>(value % range);
+        }
+    }
+    
+    // Uniform float in [0, 1)
+    float nextFloat() {
+        return (next() >> 8) * (1.0f / 16777216.0f);
+    }
+    
+    // True with the given percent chance
+    bool chance(int percent) {
+        return nextInt(100) < percent;
+    }
+
+private:
+    uint64_t m_state;
+    uint64_t m_increment;
+    uint64_t m_seed;
+    uint64_t m_stream;
+};
@@ -0,0 +1,307 @@
+#include "simd_kernels.h"
+#include <SDL.h>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// GCC/Clang need per-function target attributes to emit wider instructions
+// than the build's baseline; MSVC accepts the intrinsics without them
+#if defined(SIMD_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_TARGET(isa)
+#endif
+
+namespace {
+
+SimdLevel detectSimdLevel() {
+#ifdef SIMD_KERNELS_X86
+    if (SDL_HasAVX2()) return SimdLevel::AVX2;
+    if (SDL_HasSSE2()) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+SimdLevel g_detectedLevel = detectSimdLevel();
+SimdLevel g_activeLevel = g_detectedLevel;
+
+// Scalar reference path, also used for the tail of the vector paths
+void separationScalar(float selfX, float selfY, float selfReach, float strength,
+                      const float* x, const float* y, const float* r, int begin, int end,
+                      float& forceX, float& forceY) {
+    for (int i = begin; i < end; i++) {
+        float dx = selfX - x[i];
+        float dy = selfY - y[i];
+        float distSquared = dx * dx + dy * dy;
+        float minDistance = selfReach + r[i];
+        
+        if (distSquared >= minDistance * minDistance || distSquared == 0) continue;
+        
+        // strength * (min - d) / min along (dx, dy) / d == (dx, dy) * strength * (1/d - 1/min)
+        float scale = strength * (1.0f / std::sqrt(distSquared) - 1.0f / minDistance);
+        forceX += dx * scale;
+        forceY += dy * scale;
+    }
+}
+
+void pullScalar(float* x, float* y, const unsigned char* flags, int begin, int end,
+                float targetX, float targetY, float step) {
+    for (int i = begin; i < end; i++) {
+        if (!flags[i]) continue;
+        
+        float dx = targetX - x[i];
+        float dy = targetY - y[i];
+        float distSquared = dx * dx + dy * dy;
+        if (distSquared == 0) continue;
+        
+        float distance = std::sqrt(distSquared);
+        x[i] += (dx / distance) * step;
+        y[i] += (dy / distance) * step;
+    }
+}
+
+#ifdef SIMD_KERNELS_X86
+
+SIMD_TARGET("sse2")
+void separationSSE2(float selfX, float selfY, float selfReach, float strength,
+                    const float* x, const float* y, const float* r, int count,
+                    float& forceX, float& forceY) {
+    const __m128 sx = _mm_set1_ps(selfX);
+    const __m128 sy = _mm_set1_ps(selfY);
+    const __m128 reach = _mm_set1_ps(selfReach);
+    const __m128 str = _mm_set1_ps(strength);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    
+    __m128 accX = zero;
+    __m128 accY = zero;
+    
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(sx, _mm_loadu_ps(x + i));
+        __m128 dy = _mm_sub_ps(sy, _mm_loadu_ps(y + i));
+        __m128 distSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 minDistance = _mm_add_ps(reach, _mm_loadu_ps(r + i));
+        
+        // Squared-distance rejection: overlapping and not coincident
+        __m128 mask = _mm_and_ps(_mm_cmplt_ps(distSquared, _mm_mul_ps(minDistance, minDistance)),
+                                 _mm_cmpgt_ps(distSquared, zero));
+        if (_mm_movemask_ps(mask) == 0) continue;
+        
+        // Approximate 1/sqrt refined with one Newton-Raphson step
+        __m128 inv = _mm_rsqrt_ps(distSquared);
+        inv = _mm_mul_ps(inv, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, distSquared), _mm_mul_ps(inv, inv))));
+        
+        __m128 scale = _mm_mul_ps(str, _mm_sub_ps(inv, _mm_div_ps(one, minDistance)));
+        scale = _mm_and_ps(mask, scale);
+        
+        accX = _mm_add_ps(accX, _mm_mul_ps(dx, scale));
+        accY = _mm_add_ps(accY, _mm_mul_ps(dy, scale));
+    }
+    
+    float lanesX[4], lanesY[4];
+    _mm_storeu_ps(lanesX, accX);
+    _mm_storeu_ps(lanesY, accY);
+    forceX += (lanesX[0] + lanesX[1]) + (lanesX[2] + lanesX[3]);
+    forceY += (lanesY[0] + lanesY[1]) + (lanesY[2] + lanesY[3]);
+    
+    separationScalar(selfX, selfY, selfReach, strength, x, y, r, i, count, forceX, forceY);
+}
+
+SIMD_TARGET("avx2")
+void separationAVX2(float selfX, float selfY, float selfReach, float strength,
+                    const float* x, const float* y, const float* r, int count,
+                    float& forceX, float& forceY) {
+    const __m256 sx = _mm256_set1_ps(selfX);
+    const __m256 sy = _mm256_set1_ps(selfY);
+    const __m256 reach = _mm256_set1_ps(selfReach);
+    const __m256 str = _mm256_set1_ps(strength);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 threeHalves = _mm256_set1_ps(1.5f);
+    
+    __m256 accX = zero;
+    __m256 accY = zero;
+    
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 dx = _mm256_sub_ps(sx, _mm256_loadu_ps(x + i));
+        __m256 dy = _mm256_sub_ps(sy, _mm256_loadu_ps(y + i));
+        __m256 distSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 minDistance = _mm256_add_ps(reach, _mm256_loadu_ps(r + i));
+        
+        // Squared-distance rejection: overlapping and not coincident
+        __m256 mask = _mm256_and_ps(_mm256_cmp_ps(distSquared, _mm256_mul_ps(minDistance, minDistance), _CMP_LT_OQ),
+                                    _mm256_cmp_ps(distSquared, zero, _CMP_GT_OQ));
+        if (_mm256_movemask_ps(mask) == 0) continue;
+        
+        // Approximate 1/sqrt refined with one Newton-Raphson step
+        __m256 inv = _mm256_rsqrt_ps(distSquared);
+        inv = _mm256_mul_ps(inv, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, distSquared), _mm256_mul_ps(inv, inv))));
+        
+        __m256 scale = _mm256_mul_ps(str, _mm256_sub_ps(inv, _mm256_div_ps(one, minDistance)));
+        scale = _mm256_and_ps(mask, scale);
+        
+        accX = _mm256_add_ps(accX, _mm256_mul_ps(dx, scale));
+        accY = _mm256_add_ps(accY, _mm256_mul_ps(dy, scale));
+    }
+    
+    float lanesX[8], lanesY[8];
+    _mm256_storeu_ps(lanesX, accX);
+    _mm256_storeu_ps(lanesY, accY);
+    forceX += ((lanesX[0] + lanesX[1]) + (lanesX[2] + lanesX[3])) + ((lanesX[4] + lanesX[5]) + (lanesX[6] + lanesX[7]));
+    forceY += ((lanesY[0] + lanesY[1]) + (lanesY[2] + lanesY[3])) + ((lanesY[4] + lanesY[5]) + (lanesY[6] + lanesY[7]));
+    
+    // Remaining 0-7 candidates go through the 4-wide path and its scalar tail
+    if (i < count) {
+        separationSSE2(selfX, selfY, selfReach, strength, x + i, y + i, r + i, count - i, forceX, forceY);
+    }
+}
+
+SIMD_TARGET("sse2")
+void pullSSE2(float* x, float* y, const unsigned char* flags, int count,
+              float targetX, float targetY, float step) {
+    const __m128 tx = _mm_set1_ps(targetX);
+    const __m128 ty = _mm_set1_ps(targetY);
+    const __m128 stepWidth = _mm_set1_ps(step);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128i zeroInt = _mm_setzero_si128();
+    
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // Widen four flag bytes to lane masks
+        int flagBytes;
+        std::memcpy(&flagBytes, flags + i, sizeof(flagBytes));
+        if (flagBytes == 0) continue;
+        __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(flagBytes), zeroInt), zeroInt);
+        __m128 flagMask = _mm_castsi128_ps(_mm_cmpgt_epi32(wide, zeroInt));
+        
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        __m128 dx = _mm_sub_ps(tx, px);
+        __m128 dy = _mm_sub_ps(ty, py);
+        __m128 distSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 mask = _mm_and_ps(flagMask, _mm_cmpneq_ps(distSquared, zero));
+        
+        // Exact sqrt and divide (not rsqrt) so every path agrees with the scalar one
+        __m128 distance = _mm_sqrt_ps(distSquared);
+        __m128 nx = _mm_add_ps(px, _mm_mul_ps(_mm_div_ps(dx, distance), stepWidth));
+        __m128 ny = _mm_add_ps(py, _mm_mul_ps(_mm_div_ps(dy, distance), stepWidth));
+        
+        _mm_storeu_ps(x + i, _mm_or_ps(_mm_and_ps(mask, nx), _mm_andnot_ps(mask, px)));
+        _mm_storeu_ps(y + i, _mm_or_ps(_mm_and_ps(mask, ny), _mm_andnot_ps(mask, py)));
+    }
+    
+    pullScalar(x, y, flags, i, count, targetX, targetY, step);
+}
+
+SIMD_TARGET("avx2")
+void pullAVX2(float* x, float* y, const unsigned char* flags, int count,
+              float targetX, float targetY, float step) {
+    const __m256 tx = _mm256_set1_ps(targetX);
+    const __m256 ty = _mm256_set1_ps(targetY);
+    const __m256 stepWidth = _mm256_set1_ps(step);
+    const __m256 zero = _mm256_setzero_ps();
+    
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // Widen eight flag bytes to lane masks
+        long long flagBytes;
+        std::memcpy(&flagBytes, flags + i, sizeof(flagBytes));
+        if (flagBytes == 0) continue;
+        __m256i wide = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(flags + i)));
+        __m256 flagMask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(wide, _mm256_setzero_si256()));
+        
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        __m256 dx = _mm256_sub_ps(tx, px);
+        __m256 dy = _mm256_sub_ps(ty, py);
+        __m256 distSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 mask = _mm256_and_ps(flagMask, _mm256_cmp_ps(distSquared, zero, _CMP_NEQ_UQ));
+        
+        // Exact sqrt and divide (not rsqrt) so every path agrees with the scalar one
+        __m256 distance = _mm256_sqrt_ps(distSquared);
+        __m256 nx = _mm256_add_ps(px, _mm256_mul_ps(_mm256_div_ps(dx, distance), stepWidth));
+        __m256 ny = _mm256_add_ps(py, _mm256_mul_ps(_mm256_div_ps(dy, distance), stepWidth));
+        
+        _mm256_storeu_ps(x + i, _mm256_blendv_ps(px, nx, mask));
+        _mm256_storeu_ps(y + i, _mm256_blendv_ps(py, ny, mask));
+    }
+    
+    // Remaining 0-7 points go through the 4-wide path and its scalar tail
+    if (i < count) {
+        pullSSE2(x + i, y + i, flags + i, count - i, targetX, targetY, step);
+    }
+}
+
+#endif // SIMD_KERNELS_X86
+    
+} // namespace
+
+SimdLevel getSimdLevel() {
+    return g_activeLevel;
+}
+
+const char* getSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "AVX2";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::SCALAR:
+        default: return "scalar";
+    }
+}
+
+void setSimdLevel(SimdLevel level) {
+    g_activeLevel = (static_cast<int>(level) < static_cast<int>(g_detectedLevel)) ? level : g_detectedLevel;
+}
+
+void accumulateSeparation(float selfX, float selfY, float selfRadius, float padding, float strength,
+                          const SeparationCandidates& candidates, float& forceX, float& forceY) {
+    int count = candidates.size();
+    if (count == 0) return;
+    
+    const float* x = candidates.centerX.data();
+    const float* y = candidates.centerY.data();
+    const float* r = candidates.radius.data();
+    float selfReach = selfRadius + padding;
+    
+    switch (g_activeLevel) {
+#ifdef SIMD_KERNELS_X86
+        case SimdLevel::AVX2:
+            separationAVX2(selfX, selfY, selfReach, strength, x, y, r, count, forceX, forceY);
+            return;
+        case SimdLevel::SSE2:
+            separationSSE2(selfX, selfY, selfReach, strength, x, y, r, count, forceX, forceY);
+            return;
+#endif
+        default:
+            separationScalar(selfX, selfY, selfReach, strength, x, y, r, 0, count, forceX, forceY);
+            return;
+    }
+}
+
+void pullTowardsTarget(float* x, float* y, const unsigned char* flags, int count,
+                       float targetX, float targetY, float step) {
+    if (count <= 0) return;
+    
+    switch (g_activeLevel) {
+#ifdef SIMD_KERNELS_X86
+        case SimdLevel::AVX2:
+            pullAVX2(x, y, flags, count, targetX, targetY, step);
+            return;
+        case SimdLevel::SSE2:
+            pullSSE2(x, y, flags, count, targetX, targetY, step);
+            return;
+#endif
+        default:
+            pullScalar(x, y, flags, 0, count, targetX, targetY, step);
+            return;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+
+// Batched math kernels with SSE2/AVX2 paths and a scalar fallback.
+// The instruction set is picked once at runtime from the CPU features SDL
+// reports; non-x86 builds (e.g. Emscripten) always use the scalar path.
+
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Active instruction set for all kernels
+SimdLevel getSimdLevel();
+const char* getSimdLevelName(SimdLevel level);
+
+// Force a lower level (clamped to what the CPU supports) - for comparisons
+void setSimdLevel(SimdLevel level);
+
+// Neighbour candidates for one separation query, gathered into SoA form so the
+// kernel can load several of them per instruction
+struct SeparationCandidates {
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> radius;
+    
+    void clear() { centerX.clear(); centerY.clear(); radius.clear(); }
+    void add(float x, float y, float r) { centerX.push_back(x); centerY.push_back(y); radius.push_back(r); }
+    int size() const { return static_cast<int>(centerX.size()); }
+};
+
+// Accumulate the separation push on one body from every candidate closer than
+// (selfRadius + candidateRadius + padding). Each overlapping pair contributes
+// strength * (minDistance - distance) / minDistance along the unit vector away
+// from the candidate; coincident centres are ignored.
+void accumulateSeparation(float selfX, float selfY, float selfRadius, float padding, float strength,
+                          const SeparationCandidates& candidates, float& forceX, float& forceY);
+
+// Move every point whose flag is set by step pixels toward (targetX, targetY).
+// Positions are sub-pixel, so slow pulls at high tick rates still add up.
+// Points already on the target don't move. Every path does the same IEEE float
+// operations, so results are identical whichever instruction set runs.
+void pullTowardsTarget(float* x, float* y, const unsigned char* flags, int count,
+                       float targetX, float targetY, float step);
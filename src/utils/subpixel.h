@@ -0,0 +1,20 @@
+#pragma once
+
+// Whole-pixel coordinate of a sub-pixel position, rounding toward -infinity so
+// motion up/left crosses pixel boundaries at the same rate as motion
+// down/right. Stores keep float positions so per-tick moves smaller than a
+// pixel (slow entities, high tick rates) still add up; everything outside the
+// movement code sees whole pixels.
+inline int toPixel(float position) {
+    int truncated = static_cast<int>(position);
+    return truncated - (static_cast<float>(truncated) > position ? 1 : 0);
+}
+
+// Move a whole-pixel coordinate by delta, carrying the fraction that doesn't
+// make a whole pixel yet in remainder (for entities whose position is an int)
+inline int moveSubpixel(int position, float& remainder, float delta) {
+    remainder += delta;
+    int whole = toPixel(remainder);
+    remainder -= static_cast<float>(whole);
+    return position + whole;
+}
@@ -0,0 +1,166 @@
+// CollisionWorld queries must return exactly what a brute-force scan of the
+// enemy store returns, including after enemies shrink or die between
+// rebuilds (combat damages enemies without re-indexing them).
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/entities/enemy.h"
+#include "../src/entities/enemy_store.h"
+#include "../src/systems/collision_world.h"
+#include "../src/utils/random.h"
+
+namespace {
+
+const int CELL_SIZE = 64;
+
+struct Neighbor {
+    float distance;
+    int index;
+    bool operator<(const Neighbor& other) const {
+        return distance < other.distance || (distance == other.distance && index < other.index);
+    }
+};
+
+// Same distance expression as the world uses, so ties compare identically
+float centreDistance(const EnemyStore& enemies, size_t i, int x, int y) {
+    float dx = enemies.getCenterX(i) - x;
+    float dy = enemies.getCenterY(i) - y;
+    return static_cast<float>(sqrt(dx * dx + dy * dy));
+}
+
+std::vector<int> bruteRect(const EnemyStore& enemies, const SDL_Rect& rect) {
+    std::vector<int> hits;
+    if (rect.w <= 0 || rect.h <= 0) return hits;
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (enemies.checkCollision(i, rect)) hits.push_back(static_cast<int>(i));
+    }
+    return hits;
+}
+
+std::vector<int> bruteRadius(const EnemyStore& enemies, int x, int y, float radius) {
+    std::vector<int> hits;
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (enemies.isActive(i) && centreDistance(enemies, i, x, y) <= radius) hits.push_back(static_cast<int>(i));
+    }
+    return hits;
+}
+
+std::vector<int> bruteKNearest(const EnemyStore& enemies, int x, int y, int k, float maxRange) {
+    std::vector<Neighbor> all;
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (!enemies.isActive(i)) continue;
+        float distance = centreDistance(enemies, i, x, y);
+        if (distance < maxRange) all.push_back({distance, static_cast<int>(i)});
+    }
+    std::sort(all.begin(), all.end());
+    
+    std::vector<int> hits;
+    for (int i = 0; i < k && i < static_cast<int>(all.size()); i++) {
+        hits.push_back(all[i].index);
+    }
+    return hits;
+}
+
+// A crowd with clusters (many enemies per cell, equal distances) and sparse
+// stragglers, a few dead before indexing and more damaged or killed after
+void makeCrowd(Random& random, EnemyStore& enemies, CollisionWorld& world) {
+    enemies.clear();
+    int count = 50 + random.nextInt(600);
+    for (int i = 0; i < count; i++) {
+        int level = 1 + random.nextInt(Enemy::MAX_ENEMY_LEVEL);
+        int x, y;
+        if (random.chance(60)) {
+            x = 400 + random.nextInt(8) * 8; // Clustered on a coarse lattice: many ties
+            y = 400 + random.nextInt(8) * 8;
+        } else {
+            x = random.nextInt(1200) - 100;
+            y = random.nextInt(1200) - 100;
+        }
+        size_t index = enemies.add(x, y, level, Enemy::DEFAULT_SPEED, 0);
+        if (random.chance(5)) enemies.setActive(index, false);
+    }
+    
+    world.rebuild(enemies);
+    
+    for (size_t i = 0; i < enemies.size(); i++) {
+        if (enemies.isActive(i) && random.chance(20)) {
+            int hits = 1 + random.nextInt(3);
+            for (int h = 0; h < hits && enemies.isActive(i); h++) {
+                enemies.takeDamage(i);
+            }
+        }
+    }
+}
+
+void testQueries() {
+    Random random(19);
+    EnemyStore enemies;
+    CollisionWorld world;
+    world.initialize(CELL_SIZE, 1024);
+    std::vector<int> hits;
+    int queries = 0;
+    
+    for (int round = 0; round < 40; round++) {
+        makeCrowd(random, enemies, world);
+        
+        for (int q = 0; q < 100; q++) {
+            int x = random.nextInt(1400) - 200;
+            int y = random.nextInt(1400) - 200;
+            
+            SDL_Rect rect = {x, y, random.nextInt(200), random.nextInt(200)};
+            world.queryRect(rect, hits);
+            CHECK(hits == bruteRect(enemies, rect));
+            
+            float radius = random.nextFloat() * 300.0f;
+            world.queryRadius(x, y, radius, hits);
+            CHECK(hits == bruteRadius(enemies, x, y, radius));
+            
+            float maxRange = random.nextFloat() * 500.0f;
+            std::vector<int> expected = bruteKNearest(enemies, x, y, 1, maxRange);
+            CHECK(world.nearest(x, y, maxRange) == (expected.empty() ? -1 : expected[0]));
+            
+            int k = 1 + random.nextInt(20);
+            world.kNearest(x, y, k, maxRange, hits);
+            CHECK(hits == bruteKNearest(enemies, x, y, k, maxRange));
+            queries++;
+        }
+    }
+    std::printf("queries: %d of each kind\n", queries);
+}
+
+// Queries on an empty world, and kNearest with a k larger than any before
+void testEdgeCases() {
+    EnemyStore enemies;
+    CollisionWorld world;
+    world.initialize(CELL_SIZE, 16);
+    std::vector<int> hits = {1, 2, 3};
+    
+    world.queryRect({0, 0, 100, 100}, hits);
+    CHECK(hits.empty());
+    CHECK(world.nearest(0, 0, 100.0f) == -1);
+    
+    world.rebuild(enemies);
+    world.kNearest(0, 0, 4, 100.0f, hits);
+    CHECK(hits.empty());
+    
+    for (int i = 0; i < 10; i++) {
+        enemies.add(i * 20, 0, 1, Enemy::DEFAULT_SPEED, 0);
+    }
+    world.rebuild(enemies);
+    world.kNearest(0, 0, 3, 1000.0f, hits);
+    CHECK(hits == bruteKNearest(enemies, 0, 0, 3, 1000.0f));
+    world.kNearest(0, 0, 50, 1000.0f, hits);
+    CHECK(hits.size() == 10);
+    CHECK(hits == bruteKNearest(enemies, 0, 0, 50, 1000.0f));
+    world.kNearest(0, 0, 0, 1000.0f, hits);
+    CHECK(hits.empty());
+}
+    
+} // namespace
+
+int main() {
+    testQueries();
+    testEdgeCases();
+    return test::testResult("collision_world_test");
+}
@@ -0,0 +1,238 @@
+// Recording hits in a CombatBuffer and applying them at the end of the tick
+// must give the same outcome as applying each hit the moment it is detected:
+// the same enemy levels, sizes, knockback and deaths, and the same drops in
+// the same order (so the drop random stream advances identically). Rounds
+// mix melee swings, first-hit projectiles and explosions over clustered
+// enemies, so one enemy often takes several hits in a tick.
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/entities/enemy.h"
+#include "../src/entities/enemy_store.h"
+#include "../src/entities/item_store.h"
+#include "../src/systems/collision_world.h"
+#include "../src/systems/combat_buffer.h"
+#include "../src/utils/random.h"
+
+namespace {
+
+const int ROUNDS = 4000;
+const int ITEM_CAPACITY = 16; // Small enough that some rounds fill it
+const Uint32 CURRENT_TIME = 1000;
+
+struct Attack {
+    HitSource source;
+    SDL_Rect rect;     // Melee swing or projectile
+    int originX;       // Attacker (melee) or projectile position
+    int originY;
+    int radius;        // Explosion
+};
+
+void makeCluster(Random& random, EnemyStore& enemies) {
+    enemies.clear();
+    int count = 10 + random.nextInt(120);
+    for (int i = 0; i < count; i++) {
+        enemies.add(400 + random.nextInt(200), 400 + random.nextInt(200), 1 + random.nextInt(Enemy::MAX_ENEMY_LEVEL),
+                    Enemy::DEFAULT_SPEED, 0);
+    }
+}
+
+std::vector<Attack> makeAttacks(Random& random) {
+    std::vector<Attack> attacks;
+    int count = 1 + random.nextInt(10);
+    for (int a = 0; a < count; a++) {
+        Attack attack;
+        attack.source = static_cast<HitSource>(random.nextInt(3));
+        attack.originX = 380 + random.nextInt(240);
+        attack.originY = 380 + random.nextInt(240);
+        int w = attack.source == HitSource::MELEE ? 20 + random.nextInt(60) : 8;
+        int h = attack.source == HitSource::MELEE ? 20 + random.nextInt(60) : 8;
+        attack.rect = {attack.originX - w / 2, attack.originY - h / 2, w, h};
+        attack.radius = 20 + random.nextInt(80);
+        attacks.push_back(attack);
+    }
+    return attacks;
+}
+
+// The old path: damage, knockback and death as soon as a hit is found,
+// detecting against the live store
+void hitNow(EnemyStore& enemies, ItemStore& items, Random& dropRandom, size_t i, float dx, float dy, float distance) {
+    bool wasActive = enemies.isActive(i);
+    enemies.takeDamage(i);
+    enemies.applyKnockback(i, dx, dy, distance, CURRENT_TIME);
+    if (wasActive && !enemies.isActive(i)) {
+        Enemy::handleDeath(enemies, i, items, CURRENT_TIME, dropRandom);
+    }
+}
+
+void applyImmediately(const std::vector<Attack>& attacks, EnemyStore& enemies, ItemStore& items, Random& dropRandom) {
+    for (const Attack& attack : attacks) {
+        for (size_t i = 0; i < enemies.size(); i++) {
+            if (attack.source == HitSource::EXPLOSION) {
+                if (!enemies.isActive(i)) continue;
+                float dx = enemies.getCenterX(i) - attack.originX;
+                float dy = enemies.getCenterY(i) - attack.originY;
+                float distance = sqrt(dx * dx + dy * dy);
+                if (distance > attack.radius) continue;
+                if (distance > 0) {
+                    hitNow(enemies, items, dropRandom, i, dx / distance, dy / distance, distance);
+                } else {
+                    hitNow(enemies, items, dropRandom, i, 0.0f, 0.0f, 0.0f);
+                }
+                continue;
+            }
+            
+            if (!enemies.checkCollision(i, attack.rect)) continue;
+            float dx = enemies.getX(i) - static_cast<float>(attack.originX);
+            float dy = enemies.getY(i) - static_cast<float>(attack.originY);
+            hitNow(enemies, items, dropRandom, i, dx, dy, std::sqrt(dx * dx + dy * dy));
+            if (attack.source == HitSource::PROJECTILE) break; // Strikes the first enemy only
+        }
+    }
+}
+
+// The new path, detecting as GameManager and ProjectileSystem do
+void applyBuffered(const std::vector<Attack>& attacks, EnemyStore& enemies, ItemStore& items, Random& dropRandom,
+                   CollisionWorld& world, CombatBuffer& combat, int& maxHitsOnOne) {
+    world.rebuild(enemies);
+    combat.begin(enemies);
+    std::vector<int> hits;
+    std::vector<int> hitsPerEnemy(enemies.size(), 0);
+    
+    for (const Attack& attack : attacks) {
+        if (attack.source == HitSource::EXPLOSION) {
+            world.queryRadius(attack.originX, attack.originY, attack.radius + world.getMaxEnemySize(), hits);
+            combat.filterRadius(enemies, attack.originX, attack.originY, static_cast<float>(attack.radius), hits);
+        } else {
+            world.queryRect(attack.rect, hits);
+            combat.filterRect(enemies, attack.rect, hits);
+            if (attack.source == HitSource::PROJECTILE && hits.size() > 1) hits.resize(1);
+        }
+        
+        for (int hit : hits) {
+            size_t i = static_cast<size_t>(hit);
+            float dx, dy;
+            if (attack.source == HitSource::EXPLOSION) {
+                dx = static_cast<float>(combat.getCenterX(enemies, i) - attack.originX);
+                dy = static_cast<float>(combat.getCenterY(enemies, i) - attack.originY);
+                float distance = sqrt(dx * dx + dy * dy);
+                if (distance > 0) {
+                    combat.addHit(hit, dx / distance, dy / distance, distance, attack.source);
+                } else {
+                    combat.addHit(hit, 0.0f, 0.0f, 0.0f, attack.source);
+                }
+            } else {
+                dx = enemies.getX(i) - static_cast<float>(attack.originX);
+                dy = enemies.getY(i) - static_cast<float>(attack.originY);
+                combat.addHit(hit, dx, dy, std::sqrt(dx * dx + dy * dy), attack.source);
+            }
+            if (++hitsPerEnemy[i] > maxHitsOnOne) maxHitsOnOne = hitsPerEnemy[i];
+        }
+    }
+    
+    combat.apply(enemies, items, CURRENT_TIME, dropRandom);
+}
+
+bool sameEnemies(const EnemyStore& a, const EnemyStore& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a.isActive(i) != b.isActive(i) || a.getLevel(i) != b.getLevel(i) || a.getSize(i) != b.getSize(i) ||
+            a.getKnockbackX(i) != b.getKnockbackX(i) || a.getKnockbackY(i) != b.getKnockbackY(i) ||
+            a.isInKnockback(i, CURRENT_TIME) != b.isInKnockback(i, CURRENT_TIME)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Drops must match in order, not just as a set
+bool sameItems(const ItemStore& a, const ItemStore& b) {
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); i++) {
+        if (a.getX(i) != b.getX(i) || a.getY(i) != b.getY(i) || a.getType(i) != b.getType(i) ||
+            a.getValue(i) != b.getValue(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testMatchesImmediateApplication() {
+    Random scriptRandom(41);
+    CollisionWorld world;
+    world.initialize(64, 256);
+    CombatBuffer combat;
+    int mismatches = 0;
+    int multiHitRounds = 0;
+    int maxHitsOnOne = 0;
+    int fullStoreRounds = 0;
+    
+    for (int round = 0; round < ROUNDS; round++) {
+        Random clusterRandom(1000 + round);
+        EnemyStore immediateEnemies, bufferedEnemies;
+        makeCluster(clusterRandom, immediateEnemies);
+        clusterRandom.setSeed(1000 + round);
+        makeCluster(clusterRandom, bufferedEnemies);
+        
+        ItemStore immediateItems, bufferedItems;
+        immediateItems.initialize(ITEM_CAPACITY);
+        bufferedItems.initialize(ITEM_CAPACITY);
+        Random immediateDrops(round), bufferedDrops(round);
+        
+        std::vector<Attack> attacks = makeAttacks(scriptRandom);
+        applyImmediately(attacks, immediateEnemies, immediateItems, immediateDrops);
+        int roundMaxHits = 0;
+        applyBuffered(attacks, bufferedEnemies, bufferedItems, bufferedDrops, world, combat, roundMaxHits);
+        
+        if (!sameEnemies(immediateEnemies, bufferedEnemies)) mismatches++;
+        if (!sameItems(immediateItems, bufferedItems)) mismatches++;
+        if (immediateDrops.next() != bufferedDrops.next()) mismatches++;
+        
+        if (roundMaxHits > 1) multiHitRounds++;
+        if (roundMaxHits > maxHitsOnOne) maxHitsOnOne = roundMaxHits;
+        if (bufferedItems.getFailedAdds() > 0) fullStoreRounds++;
+    }
+    
+    CHECK(mismatches == 0);
+    CHECK(multiHitRounds > ROUNDS / 4); // Several hits on one enemy in a tick is common, not a corner case
+    CHECK(fullStoreRounds > 0);
+    std::printf("rounds: %d, with several hits on one enemy: %d (up to %d), with a full item store: %d\n",
+                ROUNDS, multiHitRounds, maxHitsOnOne, fullStoreRounds);
+}
+
+// Deaths are handled in the order their killing hits were detected, not in
+// enemy index order: here the higher-index enemy dies first, so its shard is
+// dropped first
+void testDeathsInDetectionOrder() {
+    EnemyStore enemies;
+    enemies.add(100, 100, 1, Enemy::DEFAULT_SPEED, 0);
+    enemies.add(300, 300, 1, Enemy::DEFAULT_SPEED, 0);
+    ItemStore items;
+    items.initialize(ITEM_CAPACITY);
+    Random dropRandom(3);
+    
+    CombatBuffer combat;
+    combat.begin(enemies);
+    combat.addHit(1, 1.0f, 0.0f, 1.0f, HitSource::PROJECTILE);
+    combat.addHit(0, 1.0f, 0.0f, 1.0f, HitSource::MELEE);
+    CHECK(!combat.isAlive(enemies, 0));
+    CHECK(enemies.isActive(0)); // Nothing lands before apply()
+    combat.apply(enemies, items, CURRENT_TIME, dropRandom);
+    
+    CHECK(!enemies.isActive(0));
+    CHECK(!enemies.isActive(1));
+    CHECK(items.size() >= 2);
+    CHECK(items.getType(0) == ItemType::SHARD);
+    CHECK(items.getCenterX(0) > items.getCenterX(items.size() - 1)); // Enemy 1's shard came first
+    CHECK(combat.getKillCount() == 2);
+    CHECK(combat.getPendingHitCount() == 0);
+}
+    
+} // namespace
+
+int main() {
+    testMatchesImmediateApplication();
+    testDeathsInDetectionOrder();
+    return test::testResult("combat_buffer_test");
+}
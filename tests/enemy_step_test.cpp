@@ -0,0 +1,119 @@
+// The enemy step reads neighbours only from the previous-tick snapshot, so
+// the order enemies are stepped in (and so how chunks interleave on worker
+// threads) must not change the result, even when a neighbour leaves the
+// world and is deactivated during the same tick.
+#include <algorithm>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/entities/enemy.h"
+#include "../src/entities/enemy_store.h"
+#include "../src/entities/player.h"
+#include "../src/systems/flow_field.h"
+#include "../src/systems/frame_clock.h"
+#include "../src/utils/random.h"
+#include "../src/utils/simd_kernels.h"
+
+namespace {
+
+const int WORLD_WIDTH = 2000;
+const int WORLD_HEIGHT = 2000;
+
+// Step every enemy in the given order against every other enemy as a neighbour
+void stepInOrder(EnemyStore& enemies, const std::vector<size_t>& order, const Player& player) {
+    FlowField flowField; // Never built: enemies seek the player directly
+    SeparationCandidates candidates;
+    std::vector<int> neighbours;
+    for (size_t i = 0; i < enemies.size(); i++) {
+        neighbours.push_back(static_cast<int>(i));
+    }
+    
+    FrameTime time;
+    time.tick = 1;
+    time.simTime = 1000;
+    time.dt = 1000.0f / 60.0f;
+    
+    enemies.snapshotPositions();
+    for (size_t index : order) {
+        Enemy::update(enemies, index, player, flowField, neighbours, candidates, WORLD_WIDTH, WORLD_HEIGHT, time);
+    }
+}
+
+bool sameState(const EnemyStore& a, const EnemyStore& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a.getX(i) != b.getX(i) || a.getY(i) != b.getY(i) || a.isActive(i) != b.isActive(i)) return false;
+    }
+    return true;
+}
+
+std::vector<size_t> forwardOrder(size_t count) {
+    std::vector<size_t> order;
+    for (size_t i = 0; i < count; i++) {
+        order.push_back(i);
+    }
+    return order;
+}
+
+// Two overlapping enemies at the left edge; the fast one walks out of the
+// world this tick and must still push its neighbour
+void testNeighbourLeavingWorld(const Player& player) {
+    EnemyStore start;
+    start.add(-23, 100, 1, 5.0f, 0);  // Crosses x < -24 and is deactivated
+    start.add(-14, 100, 1, 1.5f, 0);  // Overlaps it (centres 9 apart, push range 15)
+    
+    EnemyStore forward = start;
+    stepInOrder(forward, {0, 1}, player);
+    EnemyStore reverse = start;
+    stepInOrder(reverse, {1, 0}, player);
+    
+    CHECK(!forward.isActive(0));
+    CHECK(!reverse.isActive(0));
+    CHECK(sameState(forward, reverse));
+    
+    // The leaving enemy was active at the snapshot, so it still pushed
+    EnemyStore alone;
+    alone.add(-14, 100, 1, 1.5f, 0);
+    stepInOrder(alone, {0}, player);
+    CHECK(forward.getX(1) != alone.getX(0));
+}
+
+// A dense crowd straddling the world edge: forward, reverse and shuffled
+// orders must all agree
+void testCrowdOrder(const Player& player) {
+    Random random(7);
+    EnemyStore start;
+    for (int i = 0; i < 300; i++) {
+        int level = 1 + random.nextInt(Enemy::MAX_ENEMY_LEVEL);
+        start.add(-40 + random.nextInt(120), 60 + random.nextInt(80), level,
+                  Enemy::DEFAULT_SPEED + random.nextFloat() * 4.0f, 0);
+    }
+    
+    std::vector<size_t> order = forwardOrder(start.size());
+    EnemyStore forward = start;
+    stepInOrder(forward, order, player);
+    
+    std::reverse(order.begin(), order.end());
+    EnemyStore reverse = start;
+    stepInOrder(reverse, order, player);
+    
+    for (size_t i = order.size(); i > 1; i--) {
+        std::swap(order[i - 1], order[random.nextInt(static_cast<int>(i))]);
+    }
+    EnemyStore shuffled = start;
+    stepInOrder(shuffled, order, player);
+    
+    CHECK(forward.getActiveCount() < start.size()); // Some did leave the world
+    CHECK(sameState(forward, reverse));
+    CHECK(sameState(forward, shuffled));
+}
+    
+} // namespace
+
+int main() {
+    Player player;
+    player.initialize(-500, 100); // Off the left edge, so enemies walk out of the world
+    
+    testNeighbourLeavingWorld(player);
+    testCrowdOrder(player);
+    return test::testResult("enemy_step_test");
+}
@@ -0,0 +1,108 @@
+// Cost of the player collision checks on the pursuit/collision paths
+// (getCenterX/Y, getRect and checkCollision per rect), before and after
+// Entity stopped asking a virtual getSize(). "virtual size" is a copy of the
+// old Entity layout kept here only for comparison; "stored size" is the
+// real Player.
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "../src/entities/player.h"
+#include "../src/utils/random.h"
+
+namespace {
+
+const int RECTS = 500;
+const int REPS = 20000;
+const int RUNS = 7;
+
+// The old Entity: every size-dependent getter went through the vtable
+class VirtualSizedEntity {
+public:
+    virtual ~VirtualSizedEntity() {}
+    
+    void initialize(int x, int y) { m_x = x; m_y = y; }
+    int getCenterX() const { return m_x + getSize() / 2; }
+    int getCenterY() const { return m_y + getSize() / 2; }
+    SDL_Rect getRect() const { return {m_x, m_y, getSize(), getSize()}; }
+    bool checkCollision(const SDL_Rect& otherRect) const;
+    
+    virtual int getSize() const = 0;
+
+protected:
+    int m_x = 0, m_y = 0;
+};
+
+bool VirtualSizedEntity::checkCollision(const SDL_Rect& b) const {
+    SDL_Rect a = getRect();
+    return (a.x < b.x + b.w && a.x + a.w > b.x && a.y < b.y + b.h && a.y + a.h > b.y);
+}
+
+// Two derived types, chosen at run time, so the calls can't be devirtualized
+class VirtualPlayer : public VirtualSizedEntity {
+public:
+    int getSize() const override { return Player::PLAYER_SIZE; }
+};
+
+class VirtualPet : public VirtualSizedEntity {
+public:
+    int getSize() const override { return Player::PLAYER_SIZE / 2; }
+};
+
+volatile long long g_sink; // Keeps the results alive
+volatile bool g_measurePet = false; // Opaque to the compiler, so the dynamic type is unknown
+
+// The same per-rect work for either entity type; returns the best run in ns
+// per check and the checksum of the results
+template <typename EntityType>
+double nanosecondsPerCheck(const EntityType& entity, const std::vector<SDL_Rect>& rects, long long& checksum) {
+    double best = 0.0;
+    for (int run = 0; run < RUNS; run++) {
+        long long sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < REPS; rep++) {
+            for (const SDL_Rect& rect : rects) {
+                int dx = rect.x - entity.getCenterX();
+                int dy = rect.y - entity.getCenterY();
+                sum += dx + dy + entity.getRect().w;
+                if (entity.checkCollision(rect)) sum++;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() /
+                             (static_cast<double>(REPS) * rects.size());
+        if (run == 0 || nanoseconds < best) best = nanoseconds;
+        checksum = sum;
+    }
+    g_sink = checksum;
+    return best;
+}
+    
+} // namespace
+
+int main() {
+    Random random(5);
+    std::vector<SDL_Rect> rects;
+    for (int i = 0; i < RECTS; i++) {
+        rects.push_back({random.nextInt(400), random.nextInt(400), 8 + random.nextInt(40), 8 + random.nextInt(40)});
+    }
+    
+    VirtualPlayer virtualPlayer;
+    VirtualPet virtualPet;
+    VirtualSizedEntity& virtualEntity = g_measurePet ? static_cast<VirtualSizedEntity&>(virtualPet) : virtualPlayer;
+    virtualEntity.initialize(180, 190);
+    
+    Player player;
+    player.initialize(180, 190);
+    
+    long long virtualChecksum = 0, storedChecksum = 0;
+    double virtualNs = nanosecondsPerCheck(virtualEntity, rects, virtualChecksum);
+    double storedNs = nanosecondsPerCheck(player, rects, storedChecksum);
+    
+    std::printf("%-14s %8.2f ns per check\n", "virtual size", virtualNs);
+    std::printf("%-14s %8.2f ns per check\n", "stored size", storedNs);
+    if (virtualChecksum != storedChecksum) {
+        std::printf("results differ: %lld vs %lld\n", virtualChecksum, storedChecksum);
+        return 1;
+    }
+    return 0;
+}
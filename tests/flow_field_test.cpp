@@ -0,0 +1,141 @@
+// FlowField headings must lead to the target: straight at it across open
+// ground, and around blocked tiles (never through them) when the window has
+// any. A walker following the field from behind a wall has to reach the
+// target tile, and tiles with no path must report no heading.
+#include <cmath>
+#include <cstdio>
+#include "test_helpers.h"
+#include "../src/systems/flow_field.h"
+
+namespace {
+
+const int TILE = 16;
+const int WORLD = 200 * TILE;
+const int RADIUS = 40;
+
+int centre(int tile) {
+    return tile * TILE + TILE / 2;
+}
+
+// Every tile the window reaches heads straight at the target tile's centre,
+// and re-targeting never searches
+void testOpenField() {
+    FlowField field;
+    float dirX = 0.0f, dirY = 0.0f;
+    CHECK(!field.sample(100, 100, dirX, dirY)); // Never initialized
+    
+    field.initialize(WORLD, WORLD, TILE, TILE, RADIUS);
+    CHECK(field.setTarget(centre(100), centre(100)));
+    CHECK(!field.setTarget(centre(100) + 3, centre(100) - 2)); // Same tile
+    
+    int mismatches = 0;
+    int sampled = 0;
+    for (int tileY = 100 - RADIUS; tileY <= 100 + RADIUS; tileY += 3) {
+        for (int tileX = 100 - RADIUS; tileX <= 100 + RADIUS; tileX += 3) {
+            if (!field.sample(centre(tileX), centre(tileY), dirX, dirY)) continue;
+            float dx = static_cast<float>(centre(100) - centre(tileX));
+            float dy = static_cast<float>(centre(100) - centre(tileY));
+            float length = std::sqrt(dx * dx + dy * dy);
+            if (std::fabs(dirX - dx / length) > 1e-5f || std::fabs(dirY - dy / length) > 1e-5f) mismatches++;
+            sampled++;
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(sampled > 500);
+    CHECK(!field.sample(centre(100 + RADIUS + 1), centre(100), dirX, dirY)); // Outside the window
+    CHECK(!field.sample(centre(101), centre(99), dirX, dirY));               // Next to the target
+    
+    CHECK(field.setTarget(centre(101), centre(100)));
+    CHECK(field.getRebuildCount() == 2);
+    CHECK(field.getIntegrationCount() == 0);
+}
+
+// Follow the field from (x, y) in small steps. Returns the number of steps
+// taken to get within a tile of the target tile, or -1 if the walker stalled,
+// entered a blocked tile or ran out of steps.
+int walk(const FlowField& field, float x, float y, int targetTileX, int targetTileY) {
+    for (int step = 0; step < 4000; step++) {
+        int tileX = static_cast<int>(x) / TILE;
+        int tileY = static_cast<int>(y) / TILE;
+        if (field.isBlocked(tileX, tileY)) return -1;
+        if (std::abs(tileX - targetTileX) <= 1 && std::abs(tileY - targetTileY) <= 1) return step;
+        
+        float dirX, dirY;
+        if (!field.sample(static_cast<int>(x), static_cast<int>(y), dirX, dirY)) return -1;
+        x += dirX * 2.0f;
+        y += dirY * 2.0f;
+    }
+    return -1;
+}
+
+// A wall stands between the walkers and the target; they must go round an end
+void testAroundWall() {
+    FlowField field;
+    field.initialize(WORLD, WORLD, TILE, TILE, RADIUS);
+    for (int tileY = 80; tileY <= 120; tileY++) {
+        field.setBlocked(95, tileY, true);
+    }
+    CHECK(field.setTarget(centre(100), centre(100)));
+    CHECK(field.getIntegrationCount() == 1);
+    
+    // Straight ahead would run into the wall
+    float dirX = 0.0f, dirY = 0.0f;
+    CHECK(field.sample(centre(90), centre(100), dirX, dirY));
+    CHECK(std::fabs(dirY) > 0.5f);
+    
+    // On the open side headings are still straight at the target
+    CHECK(field.sample(centre(110), centre(100), dirX, dirY));
+    CHECK(std::fabs(dirX + 1.0f) < 1e-5f && std::fabs(dirY) < 1e-5f);
+    
+    int failures = 0;
+    int longest = 0;
+    for (int tileY = 70; tileY <= 130; tileY += 4) {
+        for (int tileX = 65; tileX <= 94; tileX += 4) {
+            for (int jitter = 0; jitter < TILE; jitter += 5) {
+                int steps = walk(field, static_cast<float>(tileX * TILE + jitter),
+                                 static_cast<float>(tileY * TILE + TILE - 1 - jitter), 100, 100);
+                if (steps < 0) failures++;
+                if (steps > longest) longest = steps;
+            }
+        }
+    }
+    CHECK(failures == 0);
+    std::printf("walkers around the wall: longest walk %d steps\n", longest);
+    
+    // Opening the wall again restores straight headings on the next re-target
+    for (int tileY = 80; tileY <= 120; tileY++) {
+        field.setBlocked(95, tileY, false);
+    }
+    CHECK(field.setTarget(centre(100), centre(100)));
+    CHECK(field.sample(centre(90), centre(100), dirX, dirY));
+    CHECK(std::fabs(dirX - 1.0f) < 1e-5f && std::fabs(dirY) < 1e-5f);
+    CHECK(field.getIntegrationCount() == 1);
+}
+
+// A target walled in on all sides leaves everything outside without a heading
+void testUnreachable() {
+    FlowField field;
+    field.initialize(WORLD, WORLD, TILE, TILE, RADIUS);
+    for (int i = 95; i <= 105; i++) {
+        field.setBlocked(i, 95, true);
+        field.setBlocked(i, 105, true);
+        field.setBlocked(95, i, true);
+        field.setBlocked(105, i, true);
+    }
+    field.setTarget(centre(100), centre(100));
+    
+    float dirX = 0.0f, dirY = 0.0f;
+    CHECK(!field.sample(centre(90), centre(100), dirX, dirY));
+    CHECK(!field.sample(centre(120), centre(130), dirX, dirY));
+    CHECK(field.sample(centre(103), centre(100), dirX, dirY)); // Inside the box
+    CHECK(!field.sample(centre(95), centre(100), dirX, dirY));  // On the wall itself
+}
+    
+} // namespace
+
+int main() {
+    testOpenField();
+    testAroundWall();
+    testUnreachable();
+    return test::testResult("flow_field_test");
+}
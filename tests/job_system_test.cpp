@@ -0,0 +1,194 @@
+// JobSystem under contention: many small jobs across more threads than
+// cores, so the deques are constantly stolen from. parallelFor must run
+// every index exactly once, runAfter continuations must run (after their
+// dependency, including when registered while it is still running), and the
+// system must survive being started and shut down over and over, including
+// with jobs still queued.
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/systems/job_system.h"
+
+namespace {
+
+const int THREAD_COUNTS[] = {1, 2, 3, 4, 8};
+const int CYCLES = 10; // start/shutdown cycles per thread count
+
+// Every index of [0, count) exactly once, with valid thread indices, for
+// sizes and chunkings that do and don't divide evenly
+int checkParallelForCoverage(JobSystem& jobs) {
+    const size_t counts[] = {0, 1, 7, 64, 1000, 20011};
+    const size_t chunkSizes[] = {0, 1, 3, 64, 5000};
+    int failures = 0;
+    
+    for (size_t count : counts) {
+        for (size_t chunkSize : chunkSizes) {
+            std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[count + 1]);
+            for (size_t i = 0; i < count; i++) visits[i] = 0;
+            std::atomic<int> badThreadIndex{0};
+            
+            jobs.parallelFor(count, chunkSize, [&](size_t begin, size_t end, int threadIndex) {
+                if (threadIndex < 0 || threadIndex >= jobs.getThreadCount()) badThreadIndex++;
+                for (size_t i = begin; i < end; i++) visits[i]++;
+            });
+            
+            for (size_t i = 0; i < count; i++) {
+                if (visits[i] != 1) failures++;
+            }
+            if (badThreadIndex != 0) failures++;
+        }
+    }
+    return failures;
+}
+
+// parallelFor from inside parallelFor chunks (jobs submitting and waiting)
+int checkNestedParallelFor(JobSystem& jobs) {
+    const size_t outer = 32;
+    const size_t inner = 256;
+    std::unique_ptr<std::atomic<int>[]> visits(new std::atomic<int>[outer * inner]);
+    for (size_t i = 0; i < outer * inner; i++) visits[i] = 0;
+    
+    jobs.parallelFor(outer, 1, [&](size_t begin, size_t end, int) {
+        for (size_t o = begin; o < end; o++) {
+            jobs.parallelFor(inner, 8, [&, o](size_t innerBegin, size_t innerEnd, int) {
+                for (size_t i = innerBegin; i < innerEnd; i++) visits[o * inner + i]++;
+            });
+        }
+    });
+    
+    int failures = 0;
+    for (size_t i = 0; i < outer * inner; i++) {
+        if (visits[i] != 1) failures++;
+    }
+    return failures;
+}
+
+// Chains of continuations, each link checking that the one before it ran,
+// plus a fan-in: one continuation after many jobs, registered while they run
+int checkContinuations(JobSystem& jobs) {
+    const int CHAINS = 16;
+    const int LINKS = 32;
+    const int FAN_IN = 200;
+    int failures = 0;
+    
+    std::vector<JobCounter> counters(CHAINS * LINKS);
+    std::vector<int> progress(CHAINS, 0);
+    std::atomic<int> outOfOrder{0};
+    JobCounter all;
+    for (int chain = 0; chain < CHAINS; chain++) {
+        for (int link = 0; link < LINKS; link++) {
+            JobCounter& counter = counters[chain * LINKS + link];
+            auto step = [&progress, &outOfOrder, chain, link](int) {
+                if (progress[chain] != link) outOfOrder++;
+                progress[chain] = link + 1;
+            };
+            if (link == 0) {
+                jobs.run(step, counter);
+            } else {
+                jobs.runAfter(counters[chain * LINKS + link - 1], step, counter);
+            }
+        }
+        jobs.runAfter(counters[chain * LINKS + LINKS - 1], [](int) {}, all);
+    }
+    
+    // The first job holds the dependency open until everything is queued,
+    // so the continuation is registered while it is still pending
+    std::atomic<int> finished{0};
+    std::atomic<int> fanInSawAll{0};
+    std::atomic<bool> release{false};
+    JobCounter fanInDependency, fanIn;
+    jobs.run([&release](int) {
+        while (!release) std::this_thread::yield();
+    }, fanInDependency);
+    for (int i = 0; i < FAN_IN; i++) {
+        jobs.run([&finished](int) { finished++; }, fanInDependency);
+        if (i == FAN_IN / 2) {
+            jobs.runAfter(fanInDependency, [&](int) { fanInSawAll = finished.load(); }, fanIn);
+        }
+    }
+    release = true;
+    
+    jobs.wait(all);
+    jobs.wait(fanIn);
+    for (int chain = 0; chain < CHAINS; chain++) {
+        if (progress[chain] != LINKS) failures++;
+    }
+    if (outOfOrder != 0) failures++;
+    if (fanInSawAll != FAN_IN) failures++;
+    
+    // A dependency that is already done runs the continuation straight away
+    std::atomic<int> ran{0};
+    JobCounter done, after;
+    jobs.runAfter(done, [&ran](int) { ran++; }, after);
+    jobs.wait(after);
+    if (ran != 1) failures++;
+    
+    return failures;
+}
+
+void testUnderContention() {
+    JobSystem jobs;
+    int coverageFailures = 0;
+    int nestedFailures = 0;
+    int continuationFailures = 0;
+    int cycles = 0;
+    
+    for (int threads : THREAD_COUNTS) {
+        for (int cycle = 0; cycle < CYCLES; cycle++) {
+            jobs.start(threads);
+            CHECK(jobs.isRunning());
+            CHECK(jobs.getThreadCount() == threads);
+            
+            coverageFailures += checkParallelForCoverage(jobs);
+            nestedFailures += checkNestedParallelFor(jobs);
+            continuationFailures += checkContinuations(jobs);
+            
+            // Shut down with work still queued: it must all run first
+            std::atomic<int> ran{0};
+            JobCounter pending;
+            for (int i = 0; i < 1000; i++) {
+                jobs.run([&ran](int) { ran++; }, pending);
+            }
+            jobs.shutdown();
+            CHECK(!jobs.isRunning());
+            CHECK(pending.isDone());
+            CHECK(ran == 1000);
+            cycles++;
+        }
+    }
+    
+    CHECK(coverageFailures == 0);
+    CHECK(nestedFailures == 0);
+    CHECK(continuationFailures == 0);
+    std::printf("start/shutdown cycles: %d, jobs executed: %lld, stolen: %lld\n",
+                cycles, jobs.getExecutedCount(), jobs.getStolenCount());
+}
+
+// start() on a running system restarts it, shutdown() twice is harmless, and
+// a system that was never started runs everything inline
+void testLifecycle() {
+    JobSystem inlineJobs;
+    CHECK(!inlineJobs.isRunning());
+    CHECK(checkParallelForCoverage(inlineJobs) == 0);
+    CHECK(checkContinuations(inlineJobs) == 0);
+    
+    JobSystem jobs;
+    jobs.start(4);
+    jobs.start(2);
+    CHECK(jobs.getThreadCount() == 2);
+    CHECK(checkParallelForCoverage(jobs) == 0);
+    jobs.shutdown();
+    jobs.shutdown();
+    CHECK(!jobs.isRunning());
+}
+    
+} // namespace
+
+int main() {
+    testUnderContention();
+    testLifecycle();
+    return test::testResult("job_system_test");
+}
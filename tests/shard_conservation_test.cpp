@@ -0,0 +1,120 @@
+// Score is never created or lost between kills and pickup: after every tick,
+// the player's score plus the value of the shards still on the ground equals
+// the value of every enemy killed. Ticks kill more enemies than the item
+// store holds, so drops land in a full store before coalescing runs.
+#include <cstdio>
+#include "test_helpers.h"
+#include "../src/entities/enemy.h"
+#include "../src/entities/enemy_store.h"
+#include "../src/entities/item.h"
+#include "../src/entities/item_store.h"
+#include "../src/systems/combat_buffer.h"
+#include "../src/systems/shard_coalescer.h"
+#include "../src/utils/random.h"
+
+namespace {
+
+const int TICKS = 60;
+const int ENEMIES_PER_TICK = 900; // Well over Item::MAX_ITEMS
+
+long long groundValue(const ItemStore& items) {
+    long long total = 0;
+    for (int i = 0; i < items.size(); i++) {
+        if (items.isActive(i) && items.getType(i) == ItemType::SHARD) total += items.getValue(i);
+    }
+    return total;
+}
+
+void testConservation() {
+    Random random(23);
+    Random dropRandom(29);
+    EnemyStore enemies;
+    ItemStore items;
+    items.initialize(Item::MAX_ITEMS);
+    ShardCoalescer coalescer;
+    coalescer.initialize(32, Item::MAX_SHARDS);
+    CombatBuffer combat;
+    
+    long long killedValue = 0;
+    long long score = 0;
+    int failedChecks = 0;
+    
+    for (int tick = 0; tick < TICKS; tick++) {
+        Uint32 currentTime = tick * 16;
+        
+        // A fresh wave spread over the map, several hits each (some killing
+        // hits, some not, and repeated hits on one enemy in one tick)
+        enemies.clear();
+        for (int i = 0; i < ENEMIES_PER_TICK; i++) {
+            enemies.add(random.nextInt(3000), random.nextInt(3000), 1 + random.nextInt(Enemy::MAX_ENEMY_LEVEL),
+                        Enemy::DEFAULT_SPEED, currentTime);
+        }
+        combat.begin(enemies);
+        for (int i = 0; i < ENEMIES_PER_TICK; i++) {
+            int hits = random.nextInt(Enemy::MAX_ENEMY_LEVEL + 1);
+            for (int h = 0; h < hits && combat.isAlive(enemies, i); h++) {
+                combat.addHit(i, 1.0f, 0.0f, 1.0f, HitSource::MELEE);
+            }
+        }
+        combat.apply(enemies, items, currentTime, dropRandom);
+        
+        for (size_t i = 0; i < enemies.size(); i++) {
+            if (enemies.isActive(i)) continue;
+            int value;
+            SDL_Color color;
+            Enemy::getShardProperties(enemies.getOriginalLevel(i), value, color);
+            killedValue += value;
+        }
+        
+        // The player picks up about a third of what's on the ground
+        for (int i = 0; i < items.size(); i++) {
+            if (items.isActive(i) && items.getType(i) == ItemType::SHARD && random.chance(33)) {
+                score += items.getValue(i);
+                items.setActive(i, false);
+            }
+        }
+        
+        // End of tick, as GameManager::cleanupInactiveEntities does
+        coalescer.coalesce(items);
+        items.removeInactive();
+        
+        if (score + groundValue(items) != killedValue) failedChecks++;
+    }
+    
+    CHECK(failedChecks == 0);
+    CHECK(score + groundValue(items) == killedValue);
+    CHECK(items.getFailedAdds() > 0); // The full-store path really ran
+    std::printf("killed value %lld, score %lld, on the ground %lld, adds refused while full %d\n",
+                killedValue, score, groundValue(items), items.getFailedAdds());
+}
+
+// A shard dropped into a full store goes to the nearest shard, not just any
+void testFullStoreMergesIntoNearest() {
+    ItemStore items;
+    items.initialize(3);
+    items.add(0, 0, ItemType::SHARD, 0, 1);
+    items.add(1000, 1000, ItemType::SHARD, 0, 1);
+    items.add(500, 500, ItemType::MAGNET, 0);
+    
+    EnemyStore enemies;
+    enemies.add(980, 990, 1, Enemy::DEFAULT_SPEED, 0);
+    enemies.setActive(0, false);
+    Random random(1);
+    Enemy::handleDeath(enemies, 0, items, 0, random);
+    
+    int value;
+    SDL_Color color;
+    Enemy::getShardProperties(1, value, color);
+    CHECK(items.size() == 3);
+    CHECK(items.getValue(0) == 1);
+    CHECK(items.getValue(1) == 1 + value);
+    CHECK(items.findNearestShard(500, 500) == 0); // Ties go to the lower index
+}
+    
+} // namespace
+
+int main() {
+    testConservation();
+    testFullStoreMergesIntoNearest();
+    return test::testResult("shard_conservation_test");
+}
@@ -0,0 +1,54 @@
+// Separation kernel throughput per instruction set at 8, 64 and 512
+// candidates per query (a sparse crowd, a dense cell neighbourhood and a
+// pathological pile-up).
+#include <chrono>
+#include <cstdio>
+#include "../src/utils/random.h"
+#include "../src/utils/simd_kernels.h"
+
+namespace {
+
+volatile float g_sink; // Keeps the results alive
+
+double nanosecondsPerQuery(const SeparationCandidates& candidates, int queries) {
+    float forceX = 0.0f, forceY = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        accumulateSeparation(static_cast<float>(q & 7), 0.0f, 6.0f, 3.0f, 2.0f, candidates, forceX, forceY);
+    }
+    auto end = std::chrono::steady_clock::now();
+    g_sink = forceX + forceY;
+    return std::chrono::duration<double, std::nano>(end - start).count() / queries;
+}
+    
+} // namespace
+
+int main() {
+    const int counts[] = {8, 64, 512};
+    const SimdLevel levels[] = {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2};
+    
+    std::printf("%-10s %12s %12s %12s\n", "kernel", "8 cand", "64 cand", "512 cand");
+    for (SimdLevel level : levels) {
+        setSimdLevel(level);
+        if (getSimdLevel() != level) {
+            std::printf("%-10s (not supported by this CPU)\n", getSimdLevelName(level));
+            continue;
+        }
+        
+        std::printf("%-10s", getSimdLevelName(level));
+        for (int count : counts) {
+            Random random(3);
+            SeparationCandidates candidates;
+            for (int i = 0; i < count; i++) {
+                candidates.add(random.nextFloat() * 40.0f - 20.0f, random.nextFloat() * 40.0f - 20.0f,
+                               3.0f + random.nextFloat() * 12.0f);
+            }
+            
+            int queries = 4000000 / count;
+            nanosecondsPerQuery(candidates, queries / 10); // Warm up
+            std::printf(" %9.1f ns", nanosecondsPerQuery(candidates, queries));
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Every instruction set the CPU supports must agree with the scalar path:
+// separation forces within float rounding of the approximate 1/sqrt, pull
+// results exactly.
+#include <cstdio>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/utils/random.h"
+#include "../src/utils/simd_kernels.h"
+
+namespace {
+
+const SimdLevel LEVELS[] = {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2};
+
+// Candidates around (0, 0) with a mix of overlapping, distant, coincident and
+// exactly-touching bodies
+void makeCandidates(Random& random, int count, SeparationCandidates& candidates) {
+    candidates.clear();
+    for (int i = 0; i < count; i++) {
+        switch (random.nextInt(8)) {
+            case 0:
+                candidates.add(0.0f, 0.0f, 6.0f); // Coincident: no push
+                break;
+            case 1:
+                candidates.add(15.0f, 0.0f, 6.0f); // Exactly at 6 + 6 + 3: no push
+                break;
+            default:
+                candidates.add(random.nextFloat() * 60.0f - 30.0f, random.nextFloat() * 60.0f - 30.0f,
+                               3.0f + random.nextFloat() * 12.0f);
+                break;
+        }
+    }
+}
+
+void testSeparation() {
+    Random random(7);
+    SeparationCandidates candidates;
+    int compared = 0;
+    
+    for (int round = 0; round < 2000; round++) {
+        int count = round % 70; // Covers empty, tails of every width and several full vectors
+        makeCandidates(random, count, candidates);
+        
+        setSimdLevel(SimdLevel::SCALAR);
+        float expectedX = 0.0f, expectedY = 0.0f;
+        accumulateSeparation(0.0f, 0.0f, 6.0f, 3.0f, 2.0f, candidates, expectedX, expectedY);
+        
+        for (SimdLevel level : LEVELS) {
+            setSimdLevel(level);
+            float forceX = 0.0f, forceY = 0.0f;
+            accumulateSeparation(0.0f, 0.0f, 6.0f, 3.0f, 2.0f, candidates, forceX, forceY);
+            
+            // rsqrt + one Newton step is good to ~1e-6 relative per term;
+            // summation order differs, so allow a little for cancellation
+            CHECK_NEAR(forceX, expectedX, 1e-3, 1e-4);
+            CHECK_NEAR(forceY, expectedY, 1e-3, 1e-4);
+            compared++;
+        }
+    }
+    std::printf("separation: %d comparisons\n", compared);
+}
+
+void testPull() {
+    Random random(11);
+    int compared = 0;
+    
+    for (int round = 0; round < 500; round++) {
+        int count = round % 40;
+        std::vector<float> startX(count), startY(count);
+        std::vector<unsigned char> flags(count);
+        for (int i = 0; i < count; i++) {
+            startX[i] = random.nextFloat() * 2000.0f;
+            startY[i] = random.nextFloat() * 2000.0f;
+            flags[i] = random.chance(75) ? 1 : 0;
+        }
+        if (count > 0) {
+            startX[0] = 1000.0f; // Already on the target: must not move
+            startY[0] = 1000.0f;
+        }
+        
+        std::vector<float> expectedX = startX, expectedY = startY;
+        setSimdLevel(SimdLevel::SCALAR);
+        pullTowardsTarget(expectedX.data(), expectedY.data(), flags.data(), count, 1000.0f, 1000.0f, 4.5f);
+        
+        for (SimdLevel level : LEVELS) {
+            setSimdLevel(level);
+            std::vector<float> x = startX, y = startY;
+            pullTowardsTarget(x.data(), y.data(), flags.data(), count, 1000.0f, 1000.0f, 4.5f);
+            CHECK(x == expectedX);
+            CHECK(y == expectedY);
+            compared++;
+        }
+    }
+    std::printf("pull: %d comparisons\n", compared);
+}
+    
+} // namespace
+
+int main() {
+    // Levels the CPU lacks are clamped to the best supported one
+    for (SimdLevel level : LEVELS) {
+        setSimdLevel(level);
+        std::printf("requested %s, running %s\n", getSimdLevelName(level), getSimdLevelName(getSimdLevel()));
+    }
+    
+    testSeparation();
+    testPull();
+    return test::testResult("simd_kernels_test");
+}
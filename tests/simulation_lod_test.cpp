@@ -0,0 +1,95 @@
+// Every enemy in every LOD band must be brought up to date at least once per
+// its band's interval - including enemies that have only just spawned - and
+// reduced bands must spread their steps over the ticks of the interval
+// rather than stepping the whole band at once.
+#include <climits>
+#include <cstdio>
+#include "test_helpers.h"
+#include "../src/systems/frame_clock.h"
+#include "../src/systems/game_manager.h"
+#include "../src/systems/job_system.h"
+#include "../src/systems/scenario.h"
+
+namespace {
+
+const int WORLD_SIZE = 4000;
+const int TICKS = 1200;
+
+// Narrow bands so a default-sized crowd fills all of them, including an
+// interval (3) that isn't a divisor of the largest one
+const std::vector<LodBand> TEST_BANDS = {
+    {150, 1, true},
+    {300, 2, true},
+    {450, 3, true},
+    {INT_MAX, 4, false}
+};
+
+void testEveryEnemySteps() {
+    JobSystem jobs;
+    jobs.start(1);
+    
+    GameManager gameManager;
+    gameManager.setJobSystem(&jobs);
+    gameManager.setScenario(Scenario());
+    gameManager.setSeed(1);
+    gameManager.initialize(WORLD_SIZE, WORLD_SIZE);
+    
+    SimulationLod& lod = gameManager.getSimulationLod();
+    lod.setBands(TEST_BANDS);
+    const int lastBand = lod.getBandCount() - 1;
+    
+    FrameClock clock;
+    Uint64 late = 0;
+    Uint64 checked[SimulationLod::MAX_BANDS] = {};
+    Uint64 stepsByPhase[4] = {};
+    
+    for (int tick = 0; tick < TICKS; tick++) {
+        const FrameTime& time = clock.advance();
+        gameManager.savePreviousPositions();
+        gameManager.update(time);
+        
+        // Classify as the step did: from the tick's starting positions
+        const EnemyStore& enemies = gameManager.getEnemies();
+        const Player& player = gameManager.getPlayer();
+        for (size_t i = 0; i < enemies.size(); i++) {
+            if (!enemies.isActive(i)) continue;
+            
+            int band = lod.classify(enemies.getPrevCenterX(i) - player.getCenterX(),
+                                    enemies.getPrevCenterY(i) - player.getCenterY());
+            Uint64 sinceStep = time.tick - enemies.getLastStepTick(i);
+            if (sinceStep >= static_cast<Uint64>(lod.getBand(band).interval)) late++;
+            checked[band]++;
+            
+            if (band == lastBand && sinceStep == 0) {
+                stepsByPhase[time.tick % 4]++;
+            }
+        }
+    }
+    
+    CHECK(late == 0);
+    for (int band = 0; band < lod.getBandCount(); band++) {
+        CHECK(checked[band] > 0); // The crowd really did reach every band
+    }
+    
+    // The 4-tick band steps on every tick of its interval, and no tick takes
+    // more than half of its steps
+    Uint64 totalSteps = stepsByPhase[0] + stepsByPhase[1] + stepsByPhase[2] + stepsByPhase[3];
+    for (Uint64 steps : stepsByPhase) {
+        CHECK(steps > 0);
+        CHECK(steps * 2 < totalSteps);
+    }
+    
+    std::printf("enemy-ticks checked per band: %llu %llu %llu %llu, last band steps by tick %% 4: %llu %llu %llu %llu\n",
+                static_cast<unsigned long long>(checked[0]), static_cast<unsigned long long>(checked[1]),
+                static_cast<unsigned long long>(checked[2]), static_cast<unsigned long long>(checked[3]),
+                static_cast<unsigned long long>(stepsByPhase[0]), static_cast<unsigned long long>(stepsByPhase[1]),
+                static_cast<unsigned long long>(stepsByPhase[2]), static_cast<unsigned long long>(stepsByPhase[3]));
+    jobs.shutdown();
+}
+    
+} // namespace
+
+int main() {
+    testEveryEnemySteps();
+    return test::testResult("simulation_lod_test");
+}
@@ -0,0 +1,122 @@
+// The SoA item and projectile stores drop dead entries by refilling their
+// slots from the end. Under random add/kill churn the live contents must
+// match a reference list exactly (nothing lost, duplicated or resurrected),
+// the stores must stay dense, and capacity must be respected.
+#include <algorithm>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/entities/item_store.h"
+#include "../src/systems/frame_clock.h"
+#include "../src/systems/projectile_system.h"
+#include "../src/utils/random.h"
+
+namespace {
+
+const int CAPACITY = 256;
+const int ROUNDS = 2000;
+
+// Items are identified by value (unique per add)
+std::vector<int> liveItems(const ItemStore& items) {
+    std::vector<int> values;
+    for (int i = 0; i < items.size(); i++) {
+        if (items.isActive(i)) values.push_back(items.getValue(i));
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+void testItemChurn() {
+    Random random(31);
+    ItemStore items;
+    items.initialize(CAPACITY);
+    std::vector<int> expected;
+    int nextValue = 1;
+    int mismatches = 0;
+    
+    for (int round = 0; round < ROUNDS; round++) {
+        int adds = random.nextInt(120);
+        for (int a = 0; a < adds; a++) {
+            int value = nextValue++;
+            if (items.add(random.nextInt(1000), random.nextInt(1000), ItemType::SHARD, 0, value) >= 0) {
+                expected.push_back(value);
+            }
+        }
+        
+        // Kill some, including the odd deactivate/reactivate/deactivate
+        for (int i = 0; i < items.size(); i++) {
+            if (!items.isActive(i) || !random.chance(20)) continue;
+            items.setActive(i, false);
+            if (random.chance(10)) {
+                items.setActive(i, true);
+                if (random.chance(50)) items.setActive(i, false);
+            }
+            if (!items.isActive(i)) {
+                expected.erase(std::find(expected.begin(), expected.end(), items.getValue(i)));
+            }
+        }
+        
+        items.removeInactive();
+        std::sort(expected.begin(), expected.end());
+        if (liveItems(items) != expected) mismatches++;
+        if (items.size() != static_cast<int>(expected.size())) mismatches++; // Dense: no dead slots left
+        if (items.size() > CAPACITY) mismatches++;
+    }
+    
+    CHECK(mismatches == 0);
+    CHECK(items.getFailedAdds() > 0); // Churn reached capacity
+}
+
+// Projectiles are tracked by spawn time (compared as multisets); arrows
+// retire after their lifetime, so the store churns on its own
+std::vector<Uint32> liveProjectiles(const ProjectileSystem& projectiles) {
+    std::vector<Uint32> times;
+    for (int i = 0; i < projectiles.size(); i++) {
+        if (projectiles.isActive(i)) times.push_back(projectiles.getSpawnTime(i));
+    }
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+void testProjectileChurn() {
+    Random random(37);
+    ProjectileSystem projectiles;
+    projectiles.initialize(CAPACITY);
+    Uint32 lifetime = ProjectileSystem::getTypeInfo(ProjectileType::ARROW).lifetime;
+    std::vector<Uint32> expected;
+    FrameClock clock;
+    int mismatches = 0;
+    
+    for (int round = 0; round < ROUNDS; round++) {
+        const FrameTime& time = clock.advance();
+        
+        int spawns = random.nextInt(8);
+        for (int s = 0; s < spawns; s++) {
+            // Launched up to 4 ticks ago, so projectiles expire on different ticks
+            Uint32 spawnTime = time.simTime - random.nextInt(64);
+            if (projectiles.spawn(ProjectileType::ARROW, 0, 0, 1.0f, 0.0f, spawnTime) >= 0) {
+                expected.push_back(spawnTime);
+            }
+        }
+        
+        projectiles.update(time);
+        projectiles.removeInactive();
+        expected.erase(std::remove_if(expected.begin(), expected.end(), [&](Uint32 spawnTime) {
+            return time.simTime - spawnTime > lifetime;
+        }), expected.end());
+        
+        std::sort(expected.begin(), expected.end());
+        if (liveProjectiles(projectiles) != expected) mismatches++;
+        if (projectiles.size() != static_cast<int>(expected.size())) mismatches++;
+    }
+    
+    CHECK(mismatches == 0);
+    CHECK(projectiles.getFailedSpawns() > 0); // Churn reached capacity
+}
+    
+} // namespace
+
+int main() {
+    testItemChurn();
+    testProjectileChurn();
+    return test::testResult("store_churn_test");
+}
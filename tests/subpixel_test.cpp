@@ -0,0 +1,122 @@
+// Movement must cover the same distance per simulated second at any tick
+// rate: per-tick moves below a pixel (stepScale = 60 / tick rate) are carried
+// as sub-pixel position instead of being truncated away, in every direction.
+#include <cstdlib>
+#include <vector>
+#include "test_helpers.h"
+#include "../src/entities/enemy.h"
+#include "../src/entities/enemy_store.h"
+#include "../src/entities/item.h"
+#include "../src/entities/item_store.h"
+#include "../src/entities/player.h"
+#include "../src/systems/flow_field.h"
+#include "../src/systems/frame_clock.h"
+#include "../src/utils/simd_kernels.h"
+#include "../src/utils/subpixel.h"
+
+namespace {
+
+const int TICK_RATES[] = {30, 60, 120, 240};
+
+void testToPixel() {
+    CHECK(toPixel(0.0f) == 0);
+    CHECK(toPixel(0.75f) == 0);
+    CHECK(toPixel(1.0f) == 1);
+    CHECK(toPixel(-0.25f) == -1);
+    CHECK(toPixel(-1.0f) == -1);
+    CHECK(toPixel(-1.5f) == -2);
+    
+    // Four quarter-pixel moves make one pixel either way
+    float remainder = 0.0f;
+    int x = 10;
+    for (int i = 0; i < 4; i++) {
+        x = moveSubpixel(x, remainder, 0.25f);
+    }
+    CHECK(x == 11);
+    for (int i = 0; i < 8; i++) {
+        x = moveSubpixel(x, remainder, -0.25f);
+    }
+    CHECK(x == 9);
+}
+
+// One simulated second of walking in each direction
+void testPlayer() {
+    const SDL_Scancode keys[] = {SDL_SCANCODE_W, SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_D};
+    const int expectedX[] = {0, -1, 0, 1};
+    const int expectedY[] = {-1, 0, 1, 0};
+    
+    for (int k = 0; k < 4; k++) {
+        for (int tickRate : TICK_RATES) {
+            std::vector<Uint8> keystate(SDL_NUM_SCANCODES, 0);
+            keystate[keys[k]] = 1;
+            
+            Player player;
+            player.initialize(1000, 1000);
+            for (int tick = 0; tick < tickRate; tick++) {
+                player.handleInput(keystate.data(), 60.0f / tickRate);
+            }
+            
+            int distance = 60 * Player::PLAYER_SPEED;
+            CHECK(std::abs(player.getX() - (1000 + expectedX[k] * distance)) <= 1);
+            CHECK(std::abs(player.getY() - (1000 + expectedY[k] * distance)) <= 1);
+        }
+    }
+}
+
+// A lone enemy seeking a player far to its right, then far to its left
+void testEnemy() {
+    const int targets[] = {3000, -1000};
+    for (int targetX : targets) {
+        Player player;
+        player.initialize(targetX, 1000);
+        
+        for (int tickRate : TICK_RATES) {
+            EnemyStore enemies;
+            enemies.add(1000, 1000, 1, Enemy::DEFAULT_SPEED, 0);
+            FlowField flowField; // Never built: the enemy seeks the player directly
+            SeparationCandidates candidates;
+            std::vector<int> neighbours = {0};
+            
+            FrameClock clock;
+            clock.setTickRate(tickRate);
+            for (int tick = 0; tick < tickRate; tick++) {
+                const FrameTime& time = clock.advance();
+                enemies.snapshotPositions();
+                Enemy::update(enemies, 0, player, flowField, neighbours, candidates, 4000, 4000, time);
+            }
+            
+            int distance = static_cast<int>(60 * Enemy::DEFAULT_SPEED);
+            int expected = targetX > 1000 ? 1000 + distance : 1000 - distance;
+            CHECK(enemies.isActive(0));
+            CHECK(std::abs(enemies.getX(0) - expected) <= 1);
+            CHECK(enemies.getY(0) == 1000);
+        }
+    }
+}
+
+// A shard pulled by the magnet toward a player far to its left
+void testMagnetPull() {
+    for (int tickRate : TICK_RATES) {
+        ItemStore items;
+        items.initialize(16);
+        items.add(1000, 1000, ItemType::SHARD, 0, 1);
+        
+        for (int tick = 0; tick < tickRate; tick++) {
+            Item::applyMagnetPull(items, -1000, 1000 + Item::SHARD_SIZE / 2, 60.0f / tickRate);
+        }
+        
+        int expected = 1000 - static_cast<int>(60 * Item::MAGNET_PULL_SPEED);
+        CHECK(std::abs(items.getX(0) - expected) <= 1);
+        CHECK(items.getY(0) == 1000);
+    }
+}
+    
+} // namespace
+
+int main() {
+    testToPixel();
+    testPlayer();
+    testEnemy();
+    testMagnetPull();
+    return test::testResult("subpixel_test");
+}
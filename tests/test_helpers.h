@@ -0,0 +1,42 @@
+#pragma once
+#include <cmath>
+#include <cstdio>
+
+// Minimal checks shared by the test executables. A failed CHECK prints the
+// file, line and expression and the test carries on; main() returns
+// testResult(), which is non-zero if anything failed.
+
+namespace test {
+
+inline int& failureCount() {
+    static int count = 0;
+    return count;
+}
+
+inline bool check(bool passed, const char* expression, const char* file, int line) {
+    if (!passed) {
+        std::printf("FAILED %s:%d: %s\n", file, line, expression);
+        failureCount()++;
+    }
+    return passed;
+}
+
+inline bool near(double actual, double expected, double absolute, double relative) {
+    return std::fabs(actual - expected) <= absolute + relative * std::fabs(expected);
+}
+
+inline int testResult(const char* name) {
+    if (failureCount() == 0) {
+        std::printf("%s: all checks passed\n", name);
+        return 0;
+    }
+    std::printf("%s: %d check(s) failed\n", name, failureCount());
+    return 1;
+}
+    
+} // namespace test
+
+#define CHECK(expression) test::check((expression), #expression, __FILE__, __LINE__)
+#define CHECK_NEAR(actual, expected, absolute, relative) \
+    test::check(test::near((actual), (expected), (absolute), (relative)), \
+                #actual " ~= " #expected, __FILE__, __LINE__)